@@ -124,11 +124,21 @@ void attachment_indexer_task::work() {
             segments.emplace_back(segment.filename().string());
         }
         std::string sample = segments[1];
+        auto json_access = attachments.access_readonly();
+
+        // Attachment stores contain the attachments of all caches of a sample (runtime/attachment-storage)
+        if(segments.size() == 3 && boost::filesystem::path(segments[2]).stem() == "attachment-store") {
+            for(auto it = json_access.get().begin(); it != json_access.get().end(); ++it) {
+                nlohmann::json json = it.value();
+                discover(json, {}, db_access, sample, segments[0] + "/" + it.key());
+            }
+            continue;
+        }
+
         std::string cache = segments[0];
         for (size_t j = 2; j < segments.size(); ++j) {
             cache += "/" + segments[j];
         }
-        auto json_access = attachments.access_readonly();
 
         nlohmann::json json = json_access.get();
         discover(json, {}, db_access, sample, cache);
@@ -139,4 +149,9 @@ void attachment_indexer_task::create_parameters(misaxx::misa_parameter_builder &
 
 }
 
+misaxx::misa_resource_class attachment_indexer_task::get_resource_class() const {
+    // Most time is spent reading the attachment files
+    return misaxx::misa_resource_class::io;
+}
+
 
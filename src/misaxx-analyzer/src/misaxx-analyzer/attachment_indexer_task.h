@@ -31,6 +31,8 @@ namespace misaxx_analyzer {
 
         void create_parameters(misaxx::misa_parameter_builder &t_parameters) override;
 
+        misaxx::misa_resource_class get_resource_class() const override;
+
         attachment_indexer_discover_result discover(nlohmann::json &json,
                 const std::vector<std::string> &path, misaxx::readwrite_access<attachment_index_database> &db,
                 const std::string &sample,
@@ -11,6 +11,7 @@
  */
 
 #include "misaxx-analyzer/caches/misa_output_cache.h"
+#include <misaxx/core/utils/json_io.h>
 
 void misaxx_analyzer::misa_output_cache::postprocess() {
     misa_cache::postprocess();
@@ -38,7 +39,7 @@ void misaxx_analyzer::misa_output_cache::do_link(const misaxx_analyzer::misa_out
     if(boost::filesystem::exists(get_location() / "attachments" / "exported")) {
         for(const boost::filesystem::path& entry : boost::make_iterator_range(
                 boost::filesystem::recursive_directory_iterator(get_location() / "attachments" / "exported"))) {
-            if(entry.extension() == ".json") {
+            if(misaxx::utils::is_json_file(entry)) {
                 misaxx::misa_json cache;
                 cache.force_link(get_internal_location(), entry.parent_path(), std::make_shared<misaxx::misa_json_description>(entry));
                 m_attachments.emplace_back(std::move(cache));
@@ -49,7 +50,7 @@ void misaxx_analyzer::misa_output_cache::do_link(const misaxx_analyzer::misa_out
     if(boost::filesystem::exists(get_location() / "attachments" / "imported")) {
         for(const boost::filesystem::path& entry : boost::make_iterator_range(
                 boost::filesystem::recursive_directory_iterator(get_location() / "attachments" / "imported"))) {
-            if(entry.extension() == ".json") {
+            if(misaxx::utils::is_json_file(entry)) {
                 misaxx::misa_json cache;
                 cache.force_link(get_internal_location(), entry.parent_path(), std::make_shared<misaxx::misa_json_description>(entry));
                 m_attachments.emplace_back(std::move(cache));
@@ -41,6 +41,10 @@ namespace misaxx {
 
         void push() override;
 
+        bool can_restore() const override;
+
+        void restore(const boost::filesystem::path &t_source) override;
+
     protected:
         misa_json_description
         produce_description(const boost::filesystem::path &t_location, const misa_json_pattern &t_pattern) override;
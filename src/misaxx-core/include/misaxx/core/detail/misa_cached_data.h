@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <misaxx/core/utils/log.h>
 #include <iostream>
 
 namespace misaxx {
@@ -42,8 +43,7 @@ namespace misaxx {
         if (!data)
             data = std::make_shared<Cache>();
         misaxx::cache_registry::register_cache(data);
-        std::cout << "[Cache] Linking " << t_location << " (" << t_internal_location << ") " << " into cache of type " << typeid(Cache).name()
-                  << "\n";
+        misaxx::utils::log_message(misaxx::utils::log_level::debug) << "[Cache] Linking " << t_location << " (" << t_internal_location << ") " << " into cache of type " << typeid(Cache).name();
         data->link(t_internal_location, t_location, t_description);
     }
 
@@ -55,14 +55,12 @@ namespace misaxx {
 
         // Special case simulation mode
         if (misaxx::runtime_properties::is_simulating()) {
-            std::cout << "[Cache] Linking " << t_location->internal_path() << " into cache of type "
-                      << typeid(Cache).name() << "\n";
+            misaxx::utils::log_message(misaxx::utils::log_level::debug) << "[Cache] Linking " << t_location->internal_path() << " into cache of type " << typeid(Cache).name();
             data->link(t_location->internal_path() ,"", t_location->metadata);
             return;
         }
 
-        std::cout << "[Cache] Linking " << t_location->internal_path() << " [" << t_location->external_path()
-                  << "] into cache of type " << typeid(Cache).name() << "\n";
+        misaxx::utils::log_message(misaxx::utils::log_level::debug) << "[Cache] Linking " << t_location->internal_path() << " [" << t_location->external_path() << "] into cache of type " << typeid(Cache).name();
         data->link(t_location->internal_path(), t_location->external_path(), t_location->metadata);
     }
 
@@ -92,8 +90,7 @@ namespace misaxx {
             misaxx::cache_registry::register_cache(data);
 
             if (misaxx::runtime_properties::is_simulating()) {
-                std::cout << "[Cache] Creating " << t_location->internal_path() << " as cache of type "
-                          << typeid(Cache).name() << "\n";
+                misaxx::utils::log_message(misaxx::utils::log_level::debug) << "[Cache] Creating " << t_location->internal_path() << " as cache of type " << typeid(Cache).name();
                 // Metadata is copied into the export location
                 if (t_description.unique()) {
                     t_location->metadata = t_description;
@@ -105,12 +102,11 @@ namespace misaxx {
                 return;
             }
 
-            std::cout << "[Cache] Creating " << t_location->internal_path() << " [" << t_location->external_path()
-                      << "] as cache of type " << typeid(Cache).name() << "\n";
+            misaxx::utils::log_message(misaxx::utils::log_level::debug) << "[Cache] Creating " << t_location->internal_path() << " [" << t_location->external_path() << "] as cache of type " << typeid(Cache).name();
 
             // Create the directory if necessary
             if (!boost::filesystem::exists(t_location->external_path())) {
-                std::cout << "[Cache] Creating directory " << t_location->external_path() << "\n";
+                misaxx::utils::log_message(misaxx::utils::log_level::debug) << "[Cache] Creating directory " << t_location->external_path();
                 boost::filesystem::create_directories(t_location->external_path());
             }
 
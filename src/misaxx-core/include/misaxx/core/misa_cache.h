@@ -73,6 +73,7 @@ namespace misaxx {
 
         /**
          * Returns true if the cache has currently data
+         * Thread-safe. Returns false while another thread has exclusive access.
          * @return
          */
         virtual bool has_data() = 0;
@@ -84,6 +85,51 @@ namespace misaxx {
 
         }
 
+        /**
+         * Keeps the data in memory until release() is called. Accesses neither stash nor pull retained data.
+         * Used by the runtime to hand data from a task to a fused successor without a round trip through the storage.
+         * Thread-safe.
+         */
+        virtual void retain() {
+
+        }
+
+        /**
+         * Ends a retain(). The data is stashed if it is not retained anymore.
+         * Thread-safe.
+         */
+        virtual void release() {
+
+        }
+
+        /**
+         * Returns true if all data of this cache can be copied into a single file with save() after postprocessing.
+         * Only the outputs of such caches can be kept by the memoization store and restored with restore().
+         * @return
+         */
+        virtual bool can_restore() const {
+            return false;
+        }
+
+        /**
+         * Copies all data of this cache into a file that can be passed to restore().
+         * Called after postprocessing. The default implementation copies the file get_unique_location().
+         * Only supported if can_restore() is true.
+         * @param t_target
+         * @return false if the data does not exist
+         */
+        virtual bool save(const boost::filesystem::path &t_target) const;
+
+        /**
+         * Replaces the data of this cache by the data in a file that was created by save() and loads it.
+         * Only supported if can_restore() is true.
+         * Thread-safe.
+         * @param t_source The copy that was created after postprocessing
+         */
+        virtual void restore(const boost::filesystem::path &) {
+            throw std::runtime_error("The cache " + get_location().string() + " cannot be restored!");
+        }
+
         /**
          * Returns the location interface of this cache
          * It should match the get_location() and get_unique_location() functions
@@ -0,0 +1,54 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <misaxx/core/misa_cached_data_base.h>
+
+namespace misaxx {
+
+    /**
+     * Declares the caches that are read and written by a task
+     */
+    struct misa_cache_usage {
+
+        /**
+         * Caches that are read by the task
+         */
+        std::vector<std::shared_ptr<misa_cache>> inputs;
+
+        /**
+         * Caches that are written by the task
+         */
+        std::vector<std::shared_ptr<misa_cache>> outputs;
+
+        /**
+         * Declares that the task reads from the cache
+         * @param t_cache
+         */
+        void read(const misa_cached_data_base &t_cache);
+
+        /**
+         * Declares that the task writes into the cache
+         * @param t_cache
+         */
+        void write(const misa_cached_data_base &t_cache);
+
+        /**
+         * Returns true if no caches are declared
+         * @return
+         */
+        bool empty() const;
+    };
+}
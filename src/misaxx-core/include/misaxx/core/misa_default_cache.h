@@ -14,6 +14,7 @@
 
 #include <misaxx/core/misa_cache.h>
 #include <misaxx/core/runtime/misa_runtime_properties.h>
+#include <boost/filesystem/operations.hpp>
 
 namespace misaxx {
 
@@ -88,9 +89,28 @@ namespace misaxx {
         }
 
         bool has_data() override {
+            // The cache is being pulled or stashed if it cannot be locked
+            auto lock = this->shared_lock();
+            if(!lock.try_lock())
+                return false;
             return this->has();
         }
 
+        /**
+         * misa_cache has no access to the underlying cache, which actually holds the data.
+         * Forwards to Cache::retain(), so the runtime can retain the data via the misa_cache interface.
+         */
+        void retain() override {
+            Cache::retain();
+        }
+
+        /**
+         * Forwards to Cache::release(). See retain().
+         */
+        void release() override {
+            Cache::release();
+        }
+
         std::shared_ptr<const misa_location> get_location_interface() const override {
             if(!static_cast<bool>(m_location_interface)) {
                 m_location_interface = create_location_interface();
@@ -100,6 +120,22 @@ namespace misaxx {
 
     protected:
 
+        /**
+         * Implementation of restore() for caches that can pull their data from the file get_unique_location().
+         * The file is replaced atomically and loaded with pull().
+         * @param t_source
+         */
+        void restore_unique_location(const boost::filesystem::path &t_source) {
+            auto lock = this->exclusive_lock();
+            lock.lock();
+            const boost::filesystem::path tmp_path = m_unique_location.string() + boost::filesystem::unique_path(".tmp-%%%%-%%%%").string();
+            boost::filesystem::copy_file(t_source, tmp_path);
+            boost::filesystem::rename(tmp_path, m_unique_location);
+            this->stash();
+            this->pull();
+            this->stash(std::move(lock));
+        }
+
         /**
          * Instantiates a description from the underlying pattern
          * @param t_location same as get_location()
@@ -156,6 +156,21 @@ namespace misaxx {
          */
         virtual void build_simulation(const blueprint_builder &t_builder);
 
+        /**
+         * Called by the runtime after a child of this dispatcher finished while is_build_complete() returns false.
+         * Allows dispatchers to add more children to the tree after build() was called.
+         * Always runs in the main thread
+         * @param t_builder
+         */
+        virtual void build_incremental(const blueprint_builder &t_builder);
+
+        /**
+         * Returns false if build_incremental() can create additional children
+         * The default implementation returns true
+         * @return
+         */
+        virtual bool is_build_complete() const;
+
         /**
          * Called by the runtime
          * Always runs in the main thread
@@ -168,6 +183,12 @@ namespace misaxx {
          */
         void execute_work() override;
 
+        /**
+         * Called by the runtime to add more children to an incomplete tree
+         * Always runs in the main thread
+         */
+        void execute_incremental_work();
+
         /**
          * Returns always false
          * @return
@@ -15,10 +15,13 @@
 
 #include <misaxx/core/runtime/misa_parameter_registry.h>
 #include <misaxx/core/misa_parameter_base.h>
+#include <memory>
+#include <mutex>
 
 namespace misaxx {
     /**
      * Wrapper around a parameter, including metadata
+     * The value is resolved once from the parameter file and shared by all copies of the parameter.
      * @tparam T
      */
     template<typename T> struct misa_parameter : public misa_parameter_base {
@@ -52,11 +55,26 @@ namespace misaxx {
         }
 
         /**
-         * Gets the value of this parameter from the parameter file
+         * Gets the value of this parameter from the parameter file.
+         * The value is looked up on the first call. Later calls do not allocate.
+         * Thread-safe.
          * @return
          */
-        T query() const {
-            return misaxx::parameter_registry::get_json<T>(get_location());
+        const T &query() const {
+            resolve();
+            return m_snapshot->value;
+        }
+
+        /**
+         * Looks up the value of this parameter in the parameter file if this did not happen, yet.
+         * Throws an exception if the parameter is required, but does not exist.
+         * The schema (including the default value) must be declared beforehand.
+         * Thread-safe.
+         */
+        void resolve() const {
+            std::call_once(m_snapshot->resolved, [this]() {
+                m_snapshot->value = misaxx::parameter_registry::get_json<T>(get_location());
+            });
         }
 
         /**
@@ -78,5 +96,17 @@ namespace misaxx {
             schema->document_description(std::move(description));
             return *this;
         }
+
+    private:
+
+        /**
+         * Immutable value of the parameter after it was resolved
+         */
+        struct snapshot {
+            std::once_flag resolved;
+            T value;
+        };
+
+        std::shared_ptr<snapshot> m_snapshot = std::make_shared<snapshot>();
     };
 }
@@ -13,6 +13,7 @@
 #pragma once
 
 #include <misaxx/core/misa_parameter.h>
+#include <functional>
 
 namespace misaxx {
 
@@ -25,6 +26,13 @@ namespace misaxx {
 
         explicit misa_parameter_builder(misa_worker &t_worker);
 
+        /**
+         * Looks up the values of all parameters that were created by this builder.
+         * Called by the worker after its parameters and their schemas are declared,
+         * so missing required parameters are reported before the work starts.
+         */
+        void resolve_parameters();
+
         /**
          * Creates a parameter that is equal across all samples
          * @tparam T
@@ -38,7 +46,7 @@ namespace misaxx {
             path.emplace_back(std::move(t_name));
             auto schema = misaxx::parameter_registry::register_parameter(path);
             schema->declare_optional<T>(t_default);
-            return misa_parameter<T>(std::move(path), std::move(schema));
+            return track(misa_parameter<T>(std::move(path), std::move(schema)));
         }
 
         /**
@@ -53,7 +61,7 @@ namespace misaxx {
             path.emplace_back(std::move(t_name));
             auto schema = misaxx::parameter_registry::register_parameter(path);
             schema->declare_required<T>();
-            return misa_parameter<T>(std::move(path), std::move(schema));
+            return track(misa_parameter<T>(std::move(path), std::move(schema)));
         }
 
         /**
@@ -69,7 +77,7 @@ namespace misaxx {
             path.emplace_back(std::move(t_name));
             auto schema = misaxx::parameter_registry::register_parameter(path);
             schema->declare_optional<T>(t_default);
-            return misa_parameter<T>(std::move(path), std::move(schema));
+            return track(misa_parameter<T>(std::move(path), std::move(schema)));
         }
 
         /**
@@ -84,7 +92,7 @@ namespace misaxx {
             path.emplace_back(std::move(t_name));
             auto schema = misaxx::parameter_registry::register_parameter(path);
             schema->declare_required<T>();
-            return misa_parameter<T>(std::move(path), std::move(schema));
+            return track(misa_parameter<T>(std::move(path), std::move(schema)));
         }
 
         /**
@@ -100,7 +108,7 @@ namespace misaxx {
             path.emplace_back(std::move(t_name));
             auto schema = misaxx::parameter_registry::register_parameter(path);
             schema->declare_optional<T>(t_default);
-            return misa_parameter<T>(std::move(path), std::move(schema));
+            return track(misa_parameter<T>(std::move(path), std::move(schema)));
         }
 
         /**
@@ -115,13 +123,32 @@ namespace misaxx {
             path.emplace_back(std::move(t_name));
             auto schema = misaxx::parameter_registry::register_parameter(path);
             schema->declare_required<T>();
-            return misa_parameter<T>(std::move(path), std::move(schema));
+            return track(misa_parameter<T>(std::move(path), std::move(schema)));
         }
 
     private:
 
         std::weak_ptr<misa_worker> m_worker;
 
+        /**
+         * Parameters that were created by this builder and are resolved by resolve_parameters()
+         */
+        std::vector<std::function<void()>> m_unresolved_parameters;
+
+        /**
+         * Remembers a created parameter for resolve_parameters()
+         * @tparam T
+         * @param t_parameter
+         * @return
+         */
+        template<typename T> misa_parameter<T> track(misa_parameter<T> t_parameter) {
+            // Copies of a parameter share the resolved value
+            m_unresolved_parameters.emplace_back([t_parameter]() {
+                t_parameter.resolve();
+            });
+            return t_parameter;
+        }
+
         std::vector<std::string> get_algorithm_path();
 
         std::vector<std::string> get_sample_path();
@@ -0,0 +1,30 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#pragma once
+
+namespace misaxx {
+    /**
+     * Resource that limits the runtime of a task.
+     * The runtime limits the number of tasks of each class that work at the same time.
+     */
+    enum class misa_resource_class : int {
+        /**
+         * The task is limited by the CPU (e.g. filtering or segmentation of images)
+         */
+        compute = 0,
+        /**
+         * The task is limited by the storage (e.g. reading, writing or indexing files)
+         */
+        io = 1
+    };
+}
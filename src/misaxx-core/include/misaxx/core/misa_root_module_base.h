@@ -14,6 +14,7 @@
 #include <misaxx/core/misa_module_interface.h>
 #include <misaxx/core/misa_module.h>
 #include <iostream>
+#include <optional>
 
 namespace misaxx {
 
@@ -36,6 +37,18 @@ namespace misaxx {
 
         void build(const blueprint_builder &t_builder) override;
 
+        /**
+         * Claims the next samples if less than the maximum number of samples are in flight
+         * @param t_builder
+         */
+        void build_incremental(const blueprint_builder &t_builder) override;
+
+        /**
+         * Returns false if there can be unclaimed samples
+         * @return
+         */
+        bool is_build_complete() const override;
+
         const std::vector<std::string> &get_objects() const;
 
     protected:
@@ -55,5 +68,23 @@ namespace misaxx {
 
     private:
         std::vector<std::string> m_objects;
+
+        /**
+         * Samples that still can be claimed
+         */
+        std::vector<std::string> m_unclaimed_objects;
+
+        /**
+         * Claims the next sample. If a work queue is used, the sample is claimed from the work queue.
+         * @return the sample name or an empty optional if all samples are claimed
+         */
+        std::optional<std::string> claim_next_object();
+
+        /**
+         * Returns the maximum number of samples that are in flight at the same time or 0 if all samples are
+         * created up front
+         * @return
+         */
+        static size_t get_max_objects_in_flight();
     };
 }
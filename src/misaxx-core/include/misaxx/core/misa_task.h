@@ -14,6 +14,11 @@
 
 #include <misaxx/core/misa_worker.h>
 #include <misaxx/core/misa_parameter.h>
+#include <misaxx/core/misa_cache_usage.h>
+#include <misaxx/core/misa_resource_class.h>
+#include <algorithm>
+#include <functional>
+#include <vector>
 
 namespace misaxx {
 
@@ -25,6 +30,7 @@ namespace misaxx {
     public:
 
         using parameter_list = misa_parameter_builder;
+        using cache_usage = misa_cache_usage;
         template<typename T> using parameter = misa_parameter<T>;
 
         /**
@@ -58,6 +64,16 @@ namespace misaxx {
          */
         void create_parameters(parameter_list &t_parameters) override;
 
+        /**
+         * Allows declaration of the caches that are read and written by work()
+         * Called by the runtime after create_parameters(). Caches are already linked.
+         * If a memoization store is set, tasks that declare outputs are fingerprinted and their outputs are restored
+         * from the store instead of calling work(). Attachments cannot be stored, so outputs that carry attachments
+         * after work() are not memoized.
+         * @param t_caches
+         */
+        virtual void create_cache_usage(cache_usage &t_caches);
+
         /**
          * Called by the runtime to execute the work
          */
@@ -69,15 +85,107 @@ namespace misaxx {
          */
         bool is_parallelizeable() const override;
 
+        /**
+         * Returns the estimated peak memory (in bytes) that is allocated by work().
+         * The runtime only starts tasks while the sum of their estimates fits into the memory budget.
+         * Called by the runtime after prepare_work(). Parameters and linked caches are available.
+         * The default implementation returns 0 (negligible memory).
+         * @return
+         */
+        virtual size_t get_memory_estimate() const;
+
+        /**
+         * Returns the estimated runtime (in ms) of work().
+         * The runtime prefers tasks with a long estimated remaining path and overrides estimates from the runtime history.
+         * Called by the runtime before prepare_work(). Linked caches are available.
+         * The default implementation returns 0 (unknown).
+         * @return
+         */
+        virtual double get_cost_estimate() const;
+
+        /**
+         * Returns the resource that limits the runtime of work().
+         * The runtime limits the number of tasks of each class that work at the same time (e.g. runtime/io-slots).
+         * Called by the runtime after prepare_work(). Parameters and linked caches are available.
+         * The default implementation returns misa_resource_class::compute.
+         * @return
+         */
+        virtual misa_resource_class get_resource_class() const;
+
         /**
          * Returns the parameter builder
          * @return
          */
         const misa_parameter_builder &get_parameters() const override;
 
+        /**
+         * Returns the caches that are declared to be read and written by this task
+         * @return
+         */
+        const misa_cache_usage &get_cache_usage() const;
+
+        /**
+         * Calls a function for each index in [0, t_count) from within work().
+         * Idle worker threads of the runtime join the loop, so nested parallelism neither oversubscribes the machine
+         * nor leaves it idle. If all threads are busy, the loop runs in the calling thread.
+         * If the function throws an exception, the remaining indices are skipped and the exception is rethrown.
+         * @param t_count Number of indices
+         * @param t_function Function that is called with each index. Must be thread-safe.
+         * @param t_grain Number of consecutive indices that are processed by one thread at once
+         */
+        void parallel_for(size_t t_count, const std::function<void(size_t)> &t_function, size_t t_grain = 1) const;
+
+        /**
+         * Maps each index in [0, t_count) to a value and combines the values from within work().
+         * The indices are processed like in parallel_for(). The values of each block of t_grain indices are
+         * combined in order, and then the block results are combined in order. The result is deterministic
+         * if t_combine is associative.
+         * @tparam T Result type
+         * @tparam Map Function T(size_t)
+         * @tparam Combine Function T(T, T)
+         * @param t_count Number of indices
+         * @param t_identity Value that does not change the result if combined with another value
+         * @param t_map Function that is called with each index. Must be thread-safe.
+         * @param t_combine Combines two values
+         * @param t_grain Number of consecutive indices that are processed by one thread at once
+         * @return
+         */
+        template<typename T, class Map, class Combine>
+        T parallel_reduce(size_t t_count, T t_identity, const Map &t_map, const Combine &t_combine, size_t t_grain = 1) const {
+            if(t_grain == 0)
+                t_grain = 1;
+            const size_t num_blocks = (t_count + t_grain - 1) / t_grain;
+
+            // Each block result has its own cache line. This also prevents std::vector<bool> from packing them into bits.
+            struct alignas(64) block_result {
+                T value;
+            };
+            std::vector<block_result> block_results(num_blocks, block_result { t_identity });
+            parallel_for(num_blocks, [&](size_t t_block) {
+                T &result = block_results[t_block].value;
+                const size_t end = std::min(t_count, (t_block + 1) * t_grain);
+                for(size_t i = t_block * t_grain; i < end; ++i) {
+                    result = t_combine(std::move(result), t_map(i));
+                }
+            });
+            T result = std::move(t_identity);
+            for(block_result &block : block_results) {
+                result = t_combine(std::move(result), std::move(block.value));
+            }
+            return result;
+        }
+
     private:
 
         std::unique_ptr<misa_parameter_builder> m_parameter_builder;
 
+        /**
+         * Returns true if an output cache carries attachments
+         * @return
+         */
+        bool has_output_attachments() const;
+
+        std::unique_ptr<misa_cache_usage> m_cache_usage;
+
     };
 }
@@ -50,6 +50,15 @@ namespace misaxx {
             return std::dynamic_pointer_cast<Module>(get_module());
         }
 
+        /**
+         * Returns the current module and casts it to the target type
+         * @tparam Module
+         * @return
+         */
+        template<class Module> std::shared_ptr<const Module> get_module_as() const {
+            return std::dynamic_pointer_cast<const Module>(const_cast<misa_worker*>(this)->get_module());
+        }
+
         /**
          * Returns a pointer to itself
          * @return
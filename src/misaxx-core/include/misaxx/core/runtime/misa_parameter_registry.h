@@ -39,6 +39,13 @@ namespace misaxx::parameter_registry {
      */
     extern nlohmann::json get_json_raw(const std::vector<std::string> &t_path);
 
+    /**
+     * Returns one specific value from the parameter JSON without copying it
+     * @param t_path
+     * @return nullptr if the value does not exist
+     */
+    extern const nlohmann::json *find_json_raw(const std::vector<std::string> &t_path);
+
     /**
      * Returns the current schema builder.
      * @return
@@ -54,8 +61,8 @@ namespace misaxx::parameter_registry {
       */
     template<typename T> inline T get_json(const std::vector<std::string> &t_path) {
         const bool is_simulating = misaxx::runtime_properties::is_simulating();
-        auto json = get_json_raw(t_path);
-        if(json.empty()) {
+        const nlohmann::json *json = find_json_raw(t_path);
+        if(json == nullptr || json->empty()) {
             auto schema = get_schema_builder()->resolve(t_path);
             if(schema->default_value) {
                 return schema->default_value.value().get<T>();
@@ -68,7 +75,7 @@ namespace misaxx::parameter_registry {
             }
         }
         else {
-            return json.get<T>();
+            return json->get<T>();
         }
     }
 
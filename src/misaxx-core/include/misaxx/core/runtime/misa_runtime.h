@@ -14,9 +14,12 @@
 
 #include <memory>
 #include <unordered_set>
+#include <functional>
 #include <nlohmann/json.hpp>
+#include <boost/filesystem/path.hpp>
 #include <misaxx/core/misa_json_schema_property.h>
 #include <misaxx/core/misa_module_info.h>
+#include <misaxx/core/misa_resource_class.h>
 
 namespace misaxx {
 
@@ -27,6 +30,7 @@ namespace misaxx {
     struct misa_dispatcher;
     struct misa_module_interface;
     struct misa_work_node;
+    class misa_memoization_store;
 
     struct misa_runtime {
     private:
@@ -46,6 +50,122 @@ namespace misaxx {
           */
         int get_num_threads() const;
 
+        /**
+         * Returns the number of threads the current task can use for its own parallelization.
+         * The budget is 1 if all threads of the runtime are busy with other tasks and grows if threads are idle.
+         * @return
+         */
+        int get_thread_budget() const;
+
+        /**
+         * Runs jobs in the thread pool of the runtime and blocks until all jobs are finished.
+         * The calling thread works on the jobs, too. At most get_thread_budget() threads are used.
+         * If a job throws an exception, the remaining jobs are skipped and the exception is rethrown.
+         * @param t_num_jobs Number of jobs
+         * @param t_job Function that is called with the index of each job
+         */
+        void parallel_for(int t_num_jobs, const std::function<void(int)> &t_job);
+
+        /**
+         * Registers a function that is called by prepare_and_run() before the workload is started.
+         * The settings of the runtime (e.g. the number of threads) are known at this point.
+         * Libraries use it to adapt to the runtime (e.g. MISA++ Imaging lets OpenCV share the threads of the runtime).
+         * @param t_hook
+         */
+        void add_start_hook(std::function<void(misa_runtime &)> t_hook);
+
+        /**
+         * Returns the maximum sum of memory estimates (in bytes) of tasks that work at the same time.
+         * 0 if the memory is not limited.
+         * @return
+         */
+        size_t get_memory_budget() const;
+
+        /**
+         * Returns the maximum number of parallelized tasks of the resource class that work at the same time.
+         * 0 if the number is only limited by the number of threads.
+         * @param t_class
+         * @return
+         */
+        size_t get_resource_slots(misa_resource_class t_class) const;
+
+        /**
+         * Returns the target runtime (in ms) of batches of small sibling tasks that are run by the same job.
+         * 0 if batching is disabled.
+         * @return
+         */
+        double get_batch_duration() const;
+
+        /**
+         * Returns true if a task and its only dependent task are run in the same job.
+         * @return
+         */
+        bool is_fusing_tasks() const;
+
+        /**
+         * Returns the runtime log of a previous run that is used to prioritize workers.
+         * Empty if no history is used.
+         * @return
+         */
+        const boost::filesystem::path &get_cost_history_path() const;
+
+        /**
+         * Returns the index of the shard that is processed by this runtime
+         * @return
+         */
+        int get_shard_index() const;
+
+        /**
+         * Returns the number of shards the samples are distributed to
+         * @return
+         */
+        int get_shard_count() const;
+
+        /**
+         * Returns the directory that is used to claim samples from a queue that is shared with other processes.
+         * Empty if no work queue is used.
+         * @return
+         */
+        const boost::filesystem::path &get_work_queue_path() const;
+
+        /**
+         * Returns the maximum number of samples whose subtrees exist at the same time.
+         * 0 if all samples are created up front.
+         * @return
+         */
+        size_t get_max_samples_in_flight() const;
+
+        /**
+         * Returns true if the samples are distributed to multiple processes
+         * @return
+         */
+        bool is_sharded() const;
+
+        /**
+         * Returns the directory of the store that contains memoized outputs of tasks
+         * Empty if memoization is disabled.
+         * @return
+         */
+        const boost::filesystem::path &get_memoization_store_path() const;
+
+        /**
+         * Returns the memoization store of the current run
+         * @return nullptr if memoization is disabled
+         */
+        misa_memoization_store *get_memoization_store() const;
+
+        /**
+         * Returns how the worker threads are pinned to CPUs
+         * @return "" (no pinning), "compact", "scatter" or a list of CPUs
+         */
+        const std::string &get_thread_affinity() const;
+
+        /**
+         * Returns an identifier of this process that is unique among all shards
+         * @return
+         */
+        std::string get_shard_id() const;
+
         /**
          * Returns true if the runtime is in simulation mode
          * @return
@@ -70,12 +190,43 @@ namespace misaxx {
          */
         bool is_lazily_writing_attachments() const;
 
+        /**
+         * Returns the format of exported attachment files
+         * @return "json", "cbor" or "msgpack"
+         */
+        const std::string &get_attachment_format() const;
+
+        /**
+         * Returns how exported attachments are stored
+         * @return "files" or "sample"
+         */
+        const std::string &get_attachment_storage() const;
+
         /**
          * If true, a full-detailed runtime log is created
          * @return
          */
         bool is_creating_full_runtime_log() const;
 
+        /**
+         * If true, trace spans of the workers are recorded and written as Chrome trace into the output directory
+         * @return
+         */
+        bool is_writing_trace() const;
+
+        /**
+         * If true, no parameter schema is written into the results folder
+         * @return
+         */
+        bool is_skipping_parameter_schema() const;
+
+        /**
+         * Returns the directory that caches parameter schemas of previous runs
+         * Empty if the cache is disabled.
+         * @return
+         */
+        const boost::filesystem::path &get_parameter_schema_cache_path() const;
+
         /**
          * Returns true if tasks should attempt to skip workloads
          * @return
@@ -119,6 +270,13 @@ namespace misaxx {
           */
         nlohmann::json get_parameter_value(const std::vector<std::string> &t_path) const;
 
+        /**
+         * Returns the raw JSON value of a path without copying it
+         * @param t_path
+         * @return nullptr if the value does not exist
+         */
+        const nlohmann::json *find_parameter_value(const std::vector<std::string> &t_path) const;
+
         /**
          * Returns an optional instance to a schema builder.
          * If it returns nullptr, the schema builder will be ignored.
@@ -170,6 +328,73 @@ namespace misaxx {
          */
         void set_num_threads(int threads);
 
+        /**
+         * Sets the maximum sum of memory estimates (in bytes) of tasks that work at the same time
+         * @param bytes Memory budget or 0 to disable the limit
+         */
+        void set_memory_budget(size_t bytes);
+
+        /**
+         * Sets the maximum number of parallelized tasks of the resource class that work at the same time
+         * @param t_class
+         * @param t_slots Number of slots or 0 to disable the limit
+         */
+        void set_resource_slots(misa_resource_class t_class, size_t t_slots);
+
+        /**
+         * Sets the target runtime (in ms) of batches of small sibling tasks that are run by the same job
+         * @param ms Target runtime or 0 to disable batching
+         */
+        void set_batch_duration(double ms);
+
+        /**
+         * Enables/disables task fusion.
+         * If enabled, a task whose only dependent task has no other dependencies is run in the same job as this dependent.
+         * Caches that are written by the task and read by the dependent stay in memory between both tasks.
+         * @param value
+         */
+        void set_task_fusion(bool value);
+
+        /**
+         * Sets the runtime log of a previous run that is used to prioritize workers with long remaining runtimes
+         * @param path Path to a runtime-log.json or an empty path to disable the history
+         */
+        void set_cost_history_path(const boost::filesystem::path &path);
+
+        /**
+         * Processes only the samples whose index modulo the shard count is equal to the shard index
+         * @param index
+         * @param count
+         */
+        void set_shard(int index, int count);
+
+        /**
+         * Lets this runtime claim samples one after another from a work queue directory shared with other processes
+         * @param path Path of the work queue directory or an empty path to process all samples
+         */
+        void set_work_queue_path(const boost::filesystem::path &path);
+
+        /**
+         * Limits the number of samples whose subtrees exist at the same time.
+         * Further samples are started as soon as other samples are finished. Finished samples release their
+         * subtrees and post-process their caches.
+         * @param count Maximum number of samples or 0 to create all samples up front
+         */
+        void set_max_samples_in_flight(size_t count);
+
+        /**
+         * Sets the directory of the store that contains memoized outputs of tasks
+         * @param path Path of the store or an empty path to disable memoization
+         */
+        void set_memoization_store_path(const boost::filesystem::path &path);
+
+        /**
+         * Sets how the worker threads are pinned to CPUs
+         * @param value "" or "none" (no pinning), "compact" (fill one NUMA node after another),
+         * "scatter" (distribute threads over the NUMA nodes) or a list of CPUs (e.g. "0,2,4-7")
+         */
+        void set_thread_affinity(const std::string &value);
+
         /**
          * Enabled/disabled writing attachments
          * @param value
@@ -182,12 +407,43 @@ namespace misaxx {
          */
         void set_lazy_write_attachments(bool value);
 
+        /**
+         * Sets the format of exported attachment files
+         * @param value "json", "cbor" or "msgpack". See misaxx::utils::json_format
+         */
+        void set_attachment_format(const std::string &value);
+
+        /**
+         * Sets how exported attachments are stored
+         * @param value "files" (one file per cache) or "sample" (all attachments of a sample are written into
+         * one attachment store)
+         */
+        void set_attachment_storage(const std::string &value);
+
         /**
          * Enables/disables creation of a full runtime log
          * @param value
          */
         void set_enable_full_runtime_log(bool value);
 
+        /**
+         * Enables/disables recording and writing of a Chrome trace
+         * @param value
+         */
+        void set_write_trace(bool value);
+
+        /**
+         * Enables/disables writing the parameter schema into the results folder
+         * @param value If true, no parameter schema is written
+         */
+        void set_skip_parameter_schema(bool value);
+
+        /**
+         * Sets the directory that caches parameter schemas of previous runs
+         * @param path Path of the cache or an empty path to disable the cache
+         */
+        void set_parameter_schema_cache_path(const boost::filesystem::path &path);
+
         /**
          * Enables/disables behavior to automatically skip work
          * @param value
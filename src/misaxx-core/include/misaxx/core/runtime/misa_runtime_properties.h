@@ -16,6 +16,7 @@
 #include <memory>
 #include <vector>
 #include <nlohmann/json.hpp>
+#include <boost/filesystem/path.hpp>
 #include <misaxx/core/misa_module_info.h>
 
 namespace misaxx {
@@ -42,6 +43,12 @@ namespace misaxx::runtime_properties {
      */
     extern int get_num_threads();
 
+    /**
+     * Returns the number of threads the current task can use for its own parallelization
+     * @return
+     */
+    extern int get_thread_budget();
+
     /**
      * If true, the runtime is in simulation mode and no actual work should be done
      * @return
@@ -72,4 +79,43 @@ namespace misaxx::runtime_properties {
      * @return
      */
     extern misa_module_info get_module_info();
+
+    /**
+     * Returns the index of the shard that is processed by the current runtime
+     * @return
+     */
+    extern int get_shard_index();
+
+    /**
+     * Returns the number of shards the samples are distributed to
+     * @return
+     */
+    extern int get_shard_count();
+
+    /**
+     * Returns the directory that is used to claim samples from a queue shared with other processes.
+     * Empty if no work queue is used.
+     * @return
+     */
+    extern boost::filesystem::path get_work_queue_path();
+
+    /**
+     * Returns the maximum number of samples whose subtrees exist at the same time.
+     * 0 if all samples are created up front.
+     * @return
+     */
+    extern size_t get_max_samples_in_flight();
+
+    /**
+     * Returns an identifier of the current process that is unique among all shards
+     * @return
+     */
+    extern std::string get_shard_id();
+
+    /**
+     * Returns the directory of the store that contains memoized outputs of tasks.
+     * Empty if memoization is disabled.
+     * @return
+     */
+    extern boost::filesystem::path get_memoization_store_path();
 }
\ No newline at end of file
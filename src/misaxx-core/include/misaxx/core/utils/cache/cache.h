@@ -15,6 +15,8 @@
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
+#include <atomic>
+#include <misaxx/core/utils/metrics.h>
 
 namespace misaxx::utils {
 
@@ -144,26 +146,86 @@ namespace misaxx::utils {
 
         /**
          * Tries to discard the current value with stash(). Only works if there is no other access.
+         * Does nothing while the value is retained.
          * Can be safely used from multiple threads.
          * @param existing_lock An existing lock that should be taken over
          */
         void try_stash(std::shared_lock<std::shared_mutex> existing_lock = {}) {
             if(existing_lock.owns_lock())
                 existing_lock.unlock();
+            if(is_retained())
+                return;
 
             // Need to aquire an exclusive lock
+            // The value might have been retained in the meantime
             auto lock = exclusive_lock();
-            if(lock.try_lock()) {
+            if(lock.try_lock() && !is_retained()) {
                 stash();
             }
         }
 
+        /**
+         * Pulls the value unless it is retained in memory
+         * Not thread-safe!
+         * @return true if pull() was called
+         */
+        bool pull_unless_retained() {
+            if(is_retained() && has())
+                return false;
+            pull();
+            return true;
+        }
+
+        /**
+         * Keeps the value in memory until release() is called.
+         * Accesses then neither stash the value nor pull it again.
+         * Can be safely used from multiple threads.
+         */
+        void retain() {
+            ++m_retained;
+        }
+
+        /**
+         * Ends a retain() and tries to stash the value if it is not retained anymore
+         * Can be safely used from multiple threads.
+         */
+        void release() {
+            if(--m_retained == 0) {
+                try_stash();
+            }
+        }
+
+        /**
+         * Returns true if the value is retained in memory
+         * Can be safely used from multiple threads.
+         * @return
+         */
+        bool is_retained() const {
+            return m_retained > 0;
+        }
+
+        /**
+         * Returns the performance counters of this cache type
+         * Thread-safe.
+         * @return
+         */
+        const cache_metrics &get_metrics() const {
+            const cache_metrics *metrics = m_metrics.load(std::memory_order_acquire);
+            if(metrics == nullptr) {
+                metrics = &get_cache_metrics(typeid(*this));
+                m_metrics.store(metrics, std::memory_order_release);
+            }
+            return *metrics;
+        }
+
         /**
          * Thread-saft stash() method
          * @param existing_lock
          */
         void stash(std::unique_lock<std::shared_mutex>) {
-            stash();
+            if(!is_retained()) {
+                stash();
+            }
         }
 
     private:
@@ -172,5 +234,15 @@ namespace misaxx::utils {
         * Mutex that governs access to the data
         */
         std::shared_mutex m_mutex;
+
+        /**
+         * Counters of the dynamic type. Looked up on first use.
+         */
+        mutable std::atomic<const cache_metrics*> m_metrics { nullptr };
+
+        /**
+         * Number of retain() calls without release()
+         */
+        std::atomic<int> m_retained { 0 };
     };
 }
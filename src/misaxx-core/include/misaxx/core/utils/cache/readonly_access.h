@@ -15,6 +15,7 @@
 #include <mutex>
 #include <shared_mutex>
 #include <misaxx/core/utils/cache/cache.h>
+#include <misaxx/core/utils/trace.h>
 
 namespace misaxx::utils {
     template<typename Value>
@@ -23,8 +24,15 @@ namespace misaxx::utils {
         using value_type = Value;
 
         explicit readonly_access(cache<Value> &t_cache) : m_cache(&t_cache), m_lock(t_cache.shared_lock()) {
-            m_lock.lock();
-            m_cache->pull();
+            if(!m_lock.try_lock()) {
+                trace_span span("cache", "readonly_access lock wait");
+                metric_stopwatch stopwatch(m_cache->get_metrics().shared_lock_wait);
+                m_lock.lock();
+            }
+            trace_span span("cache", "cache pull");
+            if(m_cache->pull_unless_retained()) {
+                m_cache->get_metrics().pulls.add();
+            }
         }
 
         ~readonly_access() {
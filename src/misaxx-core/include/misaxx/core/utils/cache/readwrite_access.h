@@ -15,6 +15,7 @@
 #include <mutex>
 #include <shared_mutex>
 #include <misaxx/core/utils/cache/cache.h>
+#include <misaxx/core/utils/trace.h>
 
 namespace misaxx::utils {
     /**
@@ -27,11 +28,20 @@ namespace misaxx::utils {
         using value_type = Value;
 
         explicit readwrite_access(cache<Value> &t_cache) : m_cache(&t_cache), m_lock(t_cache.exclusive_lock()) {
-            m_lock.lock();
-            m_cache->pull();
+            if(!m_lock.try_lock()) {
+                trace_span span("cache", "readwrite_access lock wait");
+                metric_stopwatch stopwatch(m_cache->get_metrics().exclusive_lock_wait);
+                m_lock.lock();
+            }
+            trace_span span("cache", "cache pull");
+            if(m_cache->pull_unless_retained()) {
+                m_cache->get_metrics().pulls.add();
+            }
         }
 
         ~readwrite_access() {
+            m_cache->get_metrics().pushes.add();
+            trace_span span("cache", "cache push");
             m_cache->push(); // Push back into the cache
             m_cache->stash(std::move(m_lock)); // We have exclusive access
         }
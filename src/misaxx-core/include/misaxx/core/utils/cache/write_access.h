@@ -15,6 +15,7 @@
 #include <mutex>
 #include <shared_mutex>
 #include <misaxx/core/utils/cache/cache.h>
+#include <misaxx/core/utils/trace.h>
 
 namespace misaxx::utils {
     /**
@@ -26,10 +27,16 @@ namespace misaxx::utils {
         using value_type = Value;
 
         explicit write_access(cache<Value> &t_cache) : m_cache(&t_cache), m_lock(t_cache.exclusive_lock()) {
-            m_lock.lock();
+            if(!m_lock.try_lock()) {
+                trace_span span("cache", "write_access lock wait");
+                metric_stopwatch stopwatch(m_cache->get_metrics().exclusive_lock_wait);
+                m_lock.lock();
+            }
         }
 
         ~write_access() {
+            m_cache->get_metrics().pushes.add();
+            trace_span span("cache", "cache push");
             m_cache->push(); // Push into the cache
             m_cache->stash(std::move(m_lock));
         }
@@ -98,6 +98,10 @@ namespace misaxx::utils {
             return m_storage.empty();
         }
 
+        void clear() {
+            m_storage.clear();
+        }
+
     private:
 
         storage_t m_storage;
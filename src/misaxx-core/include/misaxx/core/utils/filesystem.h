@@ -14,6 +14,7 @@
 
 
 #include <boost/filesystem/path.hpp>
+#include <string>
 
 namespace misaxx::utils {
 
@@ -35,6 +36,32 @@ namespace misaxx::utils {
      */
     extern boost::filesystem::path make_preferred(boost::filesystem::path path);
 
+    /**
+     * Atomically creates a lock file that contains the owner.
+     * Works with multiple processes on a shared POSIX filesystem.
+     * @param t_path
+     * @param t_owner
+     * @return false if the file already exists
+     */
+    extern bool try_create_lock_file(const boost::filesystem::path &t_path, const std::string &t_owner);
+
+    /**
+     * Holds a lock file while the object is alive
+     * The constructor blocks until the lock could be acquired. Lock files that are older than the timeout are
+     * assumed to be left over by a crashed process and are removed.
+     */
+    class scoped_lock_file {
+    public:
+        explicit scoped_lock_file(boost::filesystem::path t_path, const std::string &t_owner, int t_stale_timeout_seconds = 60);
+
+        scoped_lock_file(const scoped_lock_file &t_other) = delete;
+
+        ~scoped_lock_file();
+
+    private:
+        boost::filesystem::path m_path;
+    };
+
 }
 
 
@@ -0,0 +1,163 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#pragma once
+
+#include <string>
+#include <ostream>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include <boost/filesystem/path.hpp>
+
+namespace misaxx::utils {
+
+    /**
+     * Formats in which JSON data can be stored
+     */
+    enum class json_format {
+        /**
+         * Pretty-printed JSON (.json)
+         */
+        json,
+        /**
+         * Concise Binary Object Representation (.cbor)
+         */
+        cbor,
+        /**
+         * MessagePack (.msgpack)
+         */
+        msgpack
+    };
+
+    /**
+     * Converts a format name ("json", "cbor" or "msgpack") into the format.
+     * Throws an exception if the name is unknown.
+     * @param t_name
+     * @return
+     */
+    extern json_format parse_json_format(const std::string &t_name);
+
+    /**
+     * Returns the file extension (including the dot) of a format
+     * @param t_format
+     * @return
+     */
+    extern std::string get_json_format_extension(json_format t_format);
+
+    /**
+     * Returns true if the file has the extension of one of the JSON formats
+     * @param t_path
+     * @return
+     */
+    extern bool is_json_file(const boost::filesystem::path &t_path);
+
+    /**
+     * Returns the format of a file based on its extension. Unknown extensions are treated as JSON.
+     * @param t_path
+     * @return
+     */
+    extern json_format get_json_format(const boost::filesystem::path &t_path);
+
+    /**
+     * Reads a JSON, CBOR or MessagePack file. The format is determined by the extension.
+     * @param t_path
+     * @return
+     */
+    extern nlohmann::json read_json(const boost::filesystem::path &t_path);
+
+    /**
+     * Writes data into a file in the given format
+     * @param t_path
+     * @param t_json
+     * @param t_format
+     */
+    extern void write_json(const boost::filesystem::path &t_path, const nlohmann::json &t_json, json_format t_format);
+
+    /**
+     * Writes a JSON object member by member into a stream.
+     * Only one member is held in memory at the same time instead of the whole object.
+     * Members can be objects that are again written member by member.
+     * The resulting JSON is equivalent to writing the complete object with write_json().
+     */
+    class json_object_writer {
+    public:
+
+        /**
+         * Starts the object
+         * @param t_stream Stream that receives the data. Must be opened in binary mode for binary formats.
+         * @param t_format
+         * @param t_size Number of members that will be written
+         */
+        json_object_writer(std::ostream &t_stream, json_format t_format, size_t t_size);
+
+        json_object_writer(const json_object_writer &t_other) = delete;
+
+        /**
+         * Writes a member of the object
+         * @param t_key Must be unique within the object
+         * @param t_value
+         */
+        void write(const std::string &t_key, const nlohmann::json &t_value);
+
+        /**
+         * Starts a member that is an object. The following members are written into this object until end_object()
+         * is called.
+         * @param t_key Must be unique within the current object
+         * @param t_size Number of members that will be written into the new object
+         */
+        void begin_object(const std::string &t_key, size_t t_size);
+
+        /**
+         * Finishes an object that was started by begin_object().
+         * Throws an exception if less members than announced were written.
+         */
+        void end_object();
+
+        /**
+         * Finishes the object. Throws an exception if less members than announced were written or if
+         * an object started by begin_object() was not finished.
+         */
+        void close();
+
+    private:
+
+        struct object_state {
+            size_t size;
+            size_t written;
+        };
+
+        std::ostream &m_stream;
+        json_format m_format;
+
+        /**
+         * Objects that are currently written. The first entry is the root object.
+         */
+        std::vector<object_state> m_objects;
+
+        /**
+         * Writes the header of an object
+         * @param t_size
+         */
+        void write_object_header(size_t t_size);
+
+        /**
+         * Writes the key of the next member of the current object
+         * @param t_key
+         */
+        void write_key(const std::string &t_key);
+
+        /**
+         * Writes the end of the current object and removes it from the stack
+         */
+        void write_object_end();
+    };
+}
@@ -0,0 +1,93 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#pragma once
+
+#include <string>
+#include <sstream>
+#include <optional>
+
+namespace misaxx::utils {
+
+    /**
+     * Verbosity of log messages
+     */
+    enum class log_level {
+        error = 0,
+        warning = 1,
+        info = 2,
+        debug = 3
+    };
+
+    /**
+     * Sets the highest level of messages that are written into the log
+     * @param t_level
+     */
+    extern void set_log_level(log_level t_level);
+
+    /**
+     * Returns the highest level of messages that are written into the log
+     * @return
+     */
+    extern log_level get_log_level();
+
+    /**
+     * Returns true if messages of the level are written into the log
+     * @param t_level
+     * @return
+     */
+    extern bool is_logging(log_level t_level);
+
+    /**
+     * Adds a line to the log. The line is written to stdout by a background thread.
+     * Lines are written in the order they were added. Thread-safe and lock-free.
+     * @param t_line Line without trailing newline
+     */
+    extern void log_line(std::string t_line);
+
+    /**
+     * Writes all pending lines to stdout and blocks until they are written
+     */
+    extern void flush_log();
+
+    /**
+     * Builds a log line and adds it to the log on destruction.
+     * Values are only formatted if the level is logged.
+     * Example:
+     * misaxx::utils::log_message(misaxx::utils::log_level::info) << "Writing " << path;
+     */
+    class log_message {
+    public:
+        explicit log_message(log_level t_level);
+
+        log_message(const log_message &t_other) = delete;
+
+        ~log_message();
+
+        template<typename T> log_message &operator<<(const T &t_value) {
+            if(m_stream) {
+                *m_stream << t_value;
+            }
+            return *this;
+        }
+
+    private:
+        std::optional<std::ostringstream> m_stream;
+    };
+
+    /**
+     * Converts a string (error, warning, info, debug) into a log level
+     * @param t_name
+     * @return
+     */
+    extern log_level log_level_from_string(const std::string &t_name);
+}
@@ -0,0 +1,122 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <typeinfo>
+#include <boost/filesystem/path.hpp>
+
+namespace misaxx::utils {
+
+    /**
+     * Counter that is shared by all threads.
+     * Counters are never destroyed, so references to them can be stored.
+     */
+    struct metric_counter {
+        std::atomic<uint64_t> value { 0 };
+
+        /**
+         * Increments the counter. Thread-safe and lock-free.
+         * @param t_amount
+         */
+        void add(uint64_t t_amount = 1) {
+            value.fetch_add(t_amount, std::memory_order_relaxed);
+        }
+
+        uint64_t get() const {
+            return value.load(std::memory_order_relaxed);
+        }
+    };
+
+    /**
+     * Counters of a cache type
+     */
+    struct cache_metrics {
+        /**
+         * Number of pull() calls through an access
+         */
+        metric_counter &pulls;
+        /**
+         * Number of push() calls through an access
+         */
+        metric_counter &pushes;
+        /**
+         * Time (in ns) spent blocked while acquiring a shared lock
+         */
+        metric_counter &shared_lock_wait;
+        /**
+         * Time (in ns) spent blocked while acquiring an exclusive lock
+         */
+        metric_counter &exclusive_lock_wait;
+    };
+
+    /**
+     * Returns the counter with the given name. The counter is created if it does not exist.
+     * Thread-safe. Look up the counter once and store the reference in hot paths.
+     * @param t_name Name of the counter (e.g. "io/tiffread/bytes")
+     * @return
+     */
+    extern metric_counter &get_metric(const std::string &t_name);
+
+    /**
+     * Returns the counters of a cache type (named "cache/<type>/...")
+     * Thread-safe.
+     * @param t_type Dynamic type of the cache
+     * @return
+     */
+    extern const cache_metrics &get_cache_metrics(const std::type_info &t_type);
+
+    /**
+     * Returns the current value of all counters
+     * Thread-safe.
+     * @return
+     */
+    extern std::map<std::string, uint64_t> get_metrics();
+
+    /**
+     * Sets all counters to zero
+     * Thread-safe.
+     */
+    extern void reset_metrics();
+
+    /**
+     * Writes the current value of all counters as JSON
+     * @param t_path
+     */
+    extern void write_metrics(const boost::filesystem::path &t_path);
+
+    /**
+     * Adds the time between its construction and destruction (in ns) to a counter
+     */
+    class metric_stopwatch {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        explicit metric_stopwatch(metric_counter &t_counter) : m_counter(&t_counter), m_start(clock::now()) {
+        }
+
+        metric_stopwatch(const metric_stopwatch &t_other) = delete;
+
+        ~metric_stopwatch() {
+            m_counter->add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - m_start).count()));
+        }
+
+    private:
+        metric_counter *m_counter;
+        clock::time_point m_start;
+    };
+}
@@ -0,0 +1,57 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace misaxx::utils {
+
+    /**
+     * A NUMA node and the CPUs that belong to it
+     */
+    struct numa_node {
+        int id = 0;
+        std::vector<int> cpus;
+    };
+
+    /**
+     * Returns the NUMA nodes with the CPUs the process is allowed to run on.
+     * If the topology is not available, a single node with all CPUs is returned.
+     * @return
+     */
+    extern const std::vector<numa_node> &get_numa_topology();
+
+    /**
+     * Returns the NUMA node of the CPU or 0 if the CPU is unknown
+     * @param t_cpu
+     * @return
+     */
+    extern int get_numa_node_of_cpu(int t_cpu);
+
+    /**
+     * Calculates the CPU each thread should be pinned to
+     * @param t_mode "" or "none" (no pinning), "compact" (fill one NUMA node after another),
+     * "scatter" (distribute the threads over the NUMA nodes) or a list of CPUs (e.g. "0,2,4-7")
+     * @param t_num_threads Number of threads
+     * @return CPU of each thread. Empty if threads should not be pinned.
+     */
+    extern std::vector<int> get_thread_affinity(const std::string &t_mode, int t_num_threads);
+
+    /**
+     * Pins the current thread to a CPU. Does nothing on platforms that do not support thread affinity.
+     * @param t_cpu
+     * @return true if the thread was pinned
+     */
+    extern bool set_current_thread_affinity(int t_cpu);
+}
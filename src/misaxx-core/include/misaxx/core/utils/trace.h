@@ -0,0 +1,74 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#pragma once
+
+#include <string>
+#include <chrono>
+#include <boost/filesystem/path.hpp>
+
+namespace misaxx::utils {
+
+    /**
+     * Enables or disables the recording of trace spans.
+     * Enabling the trace clears all recorded spans.
+     * @param t_enabled
+     */
+    extern void set_tracing(bool t_enabled);
+
+    /**
+     * Returns true if trace spans are recorded
+     * @return
+     */
+    extern bool is_tracing();
+
+    /**
+     * Writes all recorded spans as Chrome trace (JSON) that can be opened in chrome://tracing or Perfetto.
+     * Must not be called while other threads record spans.
+     * @param t_path
+     */
+    extern void write_trace(const boost::filesystem::path &t_path);
+
+    /**
+     * Records the time between its construction and destruction as span of the current thread.
+     * Each thread records into its own buffer. If a buffer is full, the oldest spans are overwritten.
+     * Spans can be nested.
+     */
+    class trace_span {
+    public:
+
+        using clock = std::chrono::steady_clock;
+
+        /**
+         * Starts a span if tracing is enabled
+         * @param t_category Category of the span (e.g. "worker" or "cache")
+         * @param t_name Name of the span
+         */
+        trace_span(const char *t_category, std::string t_name);
+
+        /**
+         * Starts a span if tracing is enabled. The name is only copied if tracing is enabled.
+         * @param t_category Category of the span (e.g. "worker" or "cache")
+         * @param t_name Name of the span
+         */
+        trace_span(const char *t_category, const char *t_name);
+
+        trace_span(const trace_span &t_other) = delete;
+
+        ~trace_span();
+
+    private:
+        const char *m_category = nullptr;
+        std::string m_name;
+        clock::time_point m_start;
+    };
+}
@@ -0,0 +1,163 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#pragma once
+
+#include <functional>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include <cstddef>
+
+namespace misaxx::utils {
+
+    /**
+     * Thread pool where each worker thread owns a queue of jobs.
+     * Workers process their own queue in LIFO order and steal jobs from the other queues if their own queue is empty.
+     * If the workers are pinned to CPUs, queues of workers on the same NUMA node are stolen from first.
+     */
+    class work_stealing_pool {
+    public:
+
+        using job_type = std::function<void()>;
+
+        using exception_handler_type = std::function<void(std::exception_ptr)>;
+
+        /**
+         * Creates the pool and starts the worker threads
+         * @param t_num_threads Number of worker threads. Must be at least 1.
+         * @param t_cpus CPU each worker is pinned to. If empty, workers are not pinned.
+         * @param t_exception_handler Receives exceptions that escape from jobs. Called in the worker thread.
+         * If empty, the exceptions are logged.
+         */
+        explicit work_stealing_pool(int t_num_threads, std::vector<int> t_cpus = {}, exception_handler_type t_exception_handler = {});
+
+        work_stealing_pool(const work_stealing_pool &t_other) = delete;
+
+        /**
+         * Stops the worker threads. Jobs that are still queued are not executed.
+         */
+        ~work_stealing_pool();
+
+        /**
+         * Submits a job into the pool.
+         * If the current thread is a worker of this pool, the job is put into its own queue.
+         * Thread-safe.
+         * @param t_job
+         */
+        void submit(job_type t_job);
+
+        /**
+         * Submits a job into the queue of the given worker. Other workers can still steal the job.
+         * Thread-safe.
+         * @param t_job
+         * @param t_thread Index of the worker. If negative, the job is submitted like submit(job_type)
+         */
+        void submit(job_type t_job, int t_thread);
+
+        /**
+         * Returns the number of worker threads
+         * @return
+         */
+        int get_num_threads() const;
+
+        /**
+         * Returns the index of the current worker thread within its pool or -1 if the current thread is not a worker
+         * @return
+         */
+        static int get_current_thread_index();
+
+        /**
+         * Returns true if the workers are pinned to CPUs of more than one NUMA node
+         * @return
+         */
+        bool is_numa_aware() const;
+
+        /**
+         * Returns the NUMA node of a worker. Returns 0 if the workers are not pinned.
+         * @param t_thread
+         * @return
+         */
+        int get_numa_node(int t_thread) const;
+
+    private:
+
+        struct worker_queue {
+            std::mutex mutex;
+            std::deque<job_type> jobs;
+        };
+
+        std::vector<std::unique_ptr<worker_queue>> m_queues;
+
+        std::vector<std::thread> m_threads;
+
+        /**
+         * NUMA node of each worker
+         */
+        std::vector<int> m_numa_nodes;
+
+        /**
+         * For each worker the order in which the other queues are stolen from
+         */
+        std::vector<std::vector<size_t>> m_steal_orders;
+
+        /**
+         * Number of jobs that are queued.
+         * Signed, as a job can be taken before its submission is counted.
+         */
+        std::atomic<std::ptrdiff_t> m_queued_jobs { 0 };
+
+        /**
+         * Number of workers that wait for jobs. Submitting only notifies the workers if one of them is waiting.
+         */
+        std::atomic<int> m_sleeping_workers { 0 };
+
+        /**
+         * Number of sleeping workers that were notified, but did not wake up yet
+         */
+        int m_waking_workers = 0;
+
+        /**
+         * Queue that receives jobs from non-worker threads
+         */
+        std::atomic<size_t> m_next_external_queue { 0 };
+
+        bool m_stop = false;
+
+        std::mutex m_sleep_mutex;
+
+        std::condition_variable m_sleep_condition;
+
+        exception_handler_type m_exception_handler;
+
+        void run_worker(int t_index, int t_cpu);
+
+        /**
+         * Runs a job and passes exceptions to the exception handler, so they do not end the worker thread
+         * @param t_job
+         */
+        void run_job(job_type &t_job);
+
+        /**
+         * Takes a job from the own queue or steals it from another queue
+         * @param t_index Index of the queue that is checked first
+         * @param t_job
+         * @return
+         */
+        bool take_job(size_t t_index, job_type &t_job);
+    };
+}
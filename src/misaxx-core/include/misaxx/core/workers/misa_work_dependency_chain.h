@@ -24,6 +24,7 @@ namespace misaxx {
     /**
      * A chain builds a consecutive relationship between instances and other segments.
      * If worker instance is inserted into a chain, it will depend on all other workers that were inserted before it.
+     * Only the direct predecessor is stored as dependency, as it already depends on the workers before it.
      * Chain supports insertion of other segments in-between the chain links additionally to the initial chain dependencies.
      * All inserted worker instances will then also depend on those additional dependencies.
      *
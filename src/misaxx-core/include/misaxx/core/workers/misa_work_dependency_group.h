@@ -24,6 +24,8 @@ namespace misaxx {
 
     /**
      * A group is an organization of workers to allow another worker or another group of workers to depend on them.
+     * If more than one worker is assigned to a group with multiple dependencies, the workers depend on a single
+     * barrier node that waits for the dependencies of the group.
      */
     class misa_work_dependency_group : public misa_work_dependency_segment {
 
@@ -114,6 +116,11 @@ namespace misaxx {
         depencencies_t m_dependencies;
         depencencies_t m_as_dependencies;
 
+        /**
+         * Barrier node that waits for m_dependencies. Created on demand.
+         */
+        std::shared_ptr<misa_work_node> m_barrier;
+
     };
 
 }
\ No newline at end of file
@@ -174,6 +174,31 @@ namespace misaxx {
          */
         virtual bool dependencies_satisfied() = 0;
 
+        /**
+         * Registers a node that depends on this node.
+         * The runtime uses this list to notify the dependents as soon as this node is finished.
+         * @param t_node
+         */
+        virtual void add_dependent(misa_work_node *t_node) = 0;
+
+        /**
+         * Returns the list of nodes that were registered as dependent of this node
+         * @return
+         */
+        virtual const std::vector<misa_work_node *> &get_dependents() const = 0;
+
+        /**
+         * Sets the number of dependencies that are not finished, yet
+         * @param t_count
+         */
+        virtual void set_unfinished_dependencies(size_t t_count) = 0;
+
+        /**
+         * Notifies this node that one of its dependencies is finished
+         * @return true if all dependencies are finished
+         */
+        virtual bool notify_dependency_finished() = 0;
+
         /**
         * Returns a managed pointer to this node
         * @return
@@ -11,7 +11,7 @@
  */
 
 #include <misaxx/core/caches/misa_json_cache.h>
-#include <iomanip>
+#include <misaxx/core/utils/json_io.h>
 
 #include "misaxx/core/caches/misa_json_cache.h"
 
@@ -56,9 +56,8 @@ bool misaxx::misa_json_cache::can_pull() const {
 }
 
 void misaxx::misa_json_cache::pull() {
-    std::ifstream stream;
-    stream.open(m_filename.string());
-    stream >> m_data;
+    // CBOR and MessagePack files are detected by their extension
+    m_data = misaxx::utils::read_json(m_filename);
 }
 
 void misaxx::misa_json_cache::stash() {
@@ -66,7 +65,13 @@ void misaxx::misa_json_cache::stash() {
 }
 
 void misaxx::misa_json_cache::push() {
-    std::ofstream stream;
-    stream.open(m_filename.string());
-    stream << std::setw(4) << m_data;
+    misaxx::utils::write_json(m_filename, m_data, misaxx::utils::get_json_format(m_filename));
+}
+
+bool misaxx::misa_json_cache::can_restore() const {
+    return true;
+}
+
+void misaxx::misa_json_cache::restore(const boost::filesystem::path &t_source) {
+    restore_unique_location(t_source);
 }
@@ -11,6 +11,7 @@
  */
 
 #include <misaxx/core/filesystem/misa_filesystem_directories_importer.h>
+#include <misaxx/core/utils/log.h>
 
 using namespace misaxx;
 
@@ -23,10 +24,10 @@ misa_filesystem misa_filesystem_directories_importer::import() {
 }
 
 void misa_filesystem_directories_importer::discoverImporterEntry(const filesystem::entry &t_entry) {
-    std::cout << "[Filesystem][directories-importer] Importing entry " << t_entry->internal_path().string() << " @ " << t_entry->external_path().string() << "\n";
+    misaxx::utils::log_message(misaxx::utils::log_level::debug) << "[Filesystem][directories-importer] Importing entry " << t_entry->internal_path().string() << " @ " << t_entry->external_path().string();
     auto metadata_file = t_entry->external_path() / "misa-data.json";
     if(boost::filesystem::is_regular_file(metadata_file)) {
-        std::cout << "[Filesystem][directories-importer] Importing metadata from file " << metadata_file.string() << "\n";
+        misaxx::utils::log_message(misaxx::utils::log_level::debug) << "[Filesystem][directories-importer] Importing metadata from file " << metadata_file.string();
         nlohmann::json json;
         std::ifstream stream;
         stream.open(metadata_file.string());
@@ -11,6 +11,7 @@
  */
 
 #include <misaxx/core/filesystem/misa_filesystem_json_importer.h>
+#include <misaxx/core/utils/log.h>
 
 using namespace misaxx;
 
@@ -18,16 +19,16 @@ void misa_filesystem_json_importer::import_entry(const nlohmann::json &t_json, c
 
     if(t_json.find("external-path") != t_json.end()) {
         t_entry->custom_external = t_json["external-path"].get<std::string>();
-        std::cout << "[Filesystem][json-importer] Importing entry " << t_entry->custom_external.string() << " into " << t_entry->internal_path().string() << "\n";
+        misaxx::utils::log_message(misaxx::utils::log_level::debug) << "[Filesystem][json-importer] Importing entry " << t_entry->custom_external.string() << " into " << t_entry->internal_path().string();
     }
     else {
-        std::cout << "[Filesystem][json-importer] Importing entry " << t_entry->internal_path().string() << "\n";
+        misaxx::utils::log_message(misaxx::utils::log_level::debug) << "[Filesystem][json-importer] Importing entry " << t_entry->internal_path().string();
     }
 
     // Load the metadata from JSON or file if applicable
     // File metadata is preferred
     if(t_entry->has_external_path() && boost::filesystem::is_regular_file(t_entry->external_path() / "misa-data.json")) {
-        std::cout << "[Filesystem][json-importer] Importing metadata from file " << (t_entry->external_path() / "misa-data.json").string() << "\n";
+        misaxx::utils::log_message(misaxx::utils::log_level::debug) << "[Filesystem][json-importer] Importing metadata from file " << (t_entry->external_path() / "misa-data.json").string();
         nlohmann::json json;
         std::ifstream stream;
         stream.open((t_entry->external_path() / "misa-data.json").string());
@@ -35,7 +36,7 @@ void misa_filesystem_json_importer::import_entry(const nlohmann::json &t_json, c
         t_entry->metadata->from_json(json);
     }
     else if(t_json.find("data-metadata") != t_json.end()) {
-        std::cout << "[Filesystem][json-importer] Importing metadata from JSON" << "\n";
+        misaxx::utils::log_message(misaxx::utils::log_level::debug) << "[Filesystem][json-importer] Importing metadata from JSON";
         t_entry->metadata->from_json(t_json["data-metadata"]);
     }
 
@@ -12,9 +12,17 @@
 
 #include <misaxx/core/misa_cache.h>
 #include <misaxx/core/utils/filesystem.h>
+#include <boost/filesystem/operations.hpp>
 
 boost::filesystem::path misaxx::misa_cache::get_internal_unique_location() const {
     boost::filesystem::path relative = boost::filesystem::relative(misaxx::utils::make_preferred(get_unique_location()),
             misaxx::utils::make_preferred(get_location()));
     return misaxx::utils::make_preferred(get_internal_location()) / relative;
 }
+
+bool misaxx::misa_cache::save(const boost::filesystem::path &t_target) const {
+    if(!boost::filesystem::is_regular_file(get_unique_location()))
+        return false;
+    boost::filesystem::copy_file(get_unique_location(), t_target);
+    return true;
+}
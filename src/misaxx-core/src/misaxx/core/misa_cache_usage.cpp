@@ -0,0 +1,33 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#include <misaxx/core/misa_cache_usage.h>
+
+using namespace misaxx;
+
+void misa_cache_usage::read(const misa_cached_data_base &t_cache) {
+    auto cache = t_cache.get_cache_base();
+    if(!static_cast<bool>(cache))
+        throw std::runtime_error("Cannot declare the usage of a cache without data!");
+    inputs.emplace_back(std::move(cache));
+}
+
+void misa_cache_usage::write(const misa_cached_data_base &t_cache) {
+    auto cache = t_cache.get_cache_base();
+    if(!static_cast<bool>(cache))
+        throw std::runtime_error("Cannot declare the usage of a cache without data!");
+    outputs.emplace_back(std::move(cache));
+}
+
+bool misa_cache_usage::empty() const {
+    return inputs.empty() && outputs.empty();
+}
@@ -36,6 +36,7 @@ void misa_dispatcher::prepare_work() {
     if(!static_cast<bool>(m_builder)) {
         this->m_builder = std::make_unique<misa_dispatcher_builder>(*this);
         this->create_blueprints(*m_builder, *m_parameter_builder);
+        m_parameter_builder->resolve_parameters();
     }
 }
 
@@ -46,6 +47,18 @@ void misa_dispatcher::execute_work() {
         this->build(*m_builder);
 }
 
+void misa_dispatcher::build_incremental(const misa_dispatcher::blueprint_builder &) {
+}
+
+bool misa_dispatcher::is_build_complete() const {
+    return true;
+}
+
+void misa_dispatcher::execute_incremental_work() {
+    if (!misaxx::runtime_properties::is_simulating())
+        this->build_incremental(*m_builder);
+}
+
 bool misa_dispatcher::is_parallelizeable() const {
     return false;
 }
@@ -19,6 +19,13 @@ misa_parameter_builder::misa_parameter_builder(misa_worker &t_worker) : m_worker
 
 }
 
+void misa_parameter_builder::resolve_parameters() {
+    for(const auto &resolve : m_unresolved_parameters) {
+        resolve();
+    }
+    m_unresolved_parameters.clear();
+}
+
 std::vector<std::string> misa_parameter_builder::get_algorithm_path() {
     return m_worker.lock()->get_node()->get_algorithm_path()->get_path();
 }
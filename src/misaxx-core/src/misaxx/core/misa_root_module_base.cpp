@@ -11,6 +11,10 @@
  */
 
 #include <misaxx/core/misa_root_module_base.h>
+#include <misaxx/core/utils/log.h>
+#include <misaxx/core/utils/filesystem.h>
+#include <boost/filesystem/operations.hpp>
+#include <algorithm>
 
 void misaxx::misa_multiobject_root_interface::setup() {
 }
@@ -25,34 +29,117 @@ void misaxx::misa_root_module_base::create_blueprints(misaxx::misa_dispatcher::b
         t_blueprints.add(create_rootmodule_blueprint("__OBJECT__"));
         m_objects.emplace_back("__OBJECT__");
     } else {
-        std::cout << "[multiobject_root] Dispatching root module for all input objects ..." << "\n";
+        misaxx::utils::log_message(misaxx::utils::log_level::info) << "[multiobject_root] Dispatching root module for all input objects ...";
+        const int shard_index = misaxx::runtime_properties::get_shard_index();
+        const int shard_count = misaxx::runtime_properties::get_shard_count();
+        const bool use_work_queue = !misaxx::runtime_properties::get_work_queue_path().empty();
+        const size_t max_objects_in_flight = get_max_objects_in_flight();
+        if (shard_count > 1) {
+            misaxx::utils::log_message(misaxx::utils::log_level::info) << "[multiobject_root] Processing shard " << shard_index << "/" << shard_count;
+        }
+
+        // The order of samples is the same in all processes
         const nlohmann::json &object_json = misaxx::parameter_registry::get_parameter_json()["samples"];
-        for (nlohmann::json::const_iterator it = object_json.begin(); it != object_json.end(); ++it) {
+        int object_index = 0;
+        for (nlohmann::json::const_iterator it = object_json.begin(); it != object_json.end(); ++it, ++object_index) {
             const std::string &name = it.key();
 
             if(name == "__OBJECT__") {
                 throw std::runtime_error("The sample name '__OBJECT__' is reserved for internal usage.");
             }
+            if(object_index % shard_count != shard_index) {
+                continue;
+            }
 
             filesystem::entry e = filesystem.imported->resolve(name);
             if (e->has_external_path()) {
                 if (boost::filesystem::is_directory(e->external_path())) {
-                    std::cout << "[multiobject_root] Found object " << name << ". External path "
-                              << e->external_path().string() << " is valid." << "\n";
+                    misaxx::utils::log_message(misaxx::utils::log_level::debug) << "[multiobject_root] Found object " << name << ". External path " << e->external_path().string() << " is valid.";
 
                 } else {
-                    std::cout << "[multiobject_root] Warning: Found object " << name << ", but external path "
-                              << e->external_path().string() << " does not exist." << "\n";
+                    misaxx::utils::log_message(misaxx::utils::log_level::warning) << "[multiobject_root] Warning: Found object " << name << ", but external path " << e->external_path().string() << " does not exist.";
                 }
 
-                t_blueprints.add(create_rootmodule_blueprint(name));
-                m_objects.push_back(name);
+                if(max_objects_in_flight > 0) {
+                    m_unclaimed_objects.push_back(name);
+                }
+                else {
+                    t_blueprints.add(create_rootmodule_blueprint(name));
+                    m_objects.push_back(name);
+                }
             } else {
-                std::cout << "[multiobject_root] Found object " << name
-                          << ", but it has no external path. Skipping." << "\n";
+                misaxx::utils::log_message(misaxx::utils::log_level::debug) << "[multiobject_root] Found object " << name << ", but it has no external path. Skipping.";
             }
         }
+
+        // Samples are claimed one after another if only a limited number of samples can be in flight
+        if(max_objects_in_flight > 0) {
+            if(!use_work_queue) {
+                misaxx::utils::log_message(misaxx::utils::log_level::info) << "[multiobject_root] Processing at most " << max_objects_in_flight << " objects at the same time";
+            }
+            std::reverse(m_unclaimed_objects.begin(), m_unclaimed_objects.end());
+            for(size_t i = 0; i < max_objects_in_flight; ++i) {
+                const auto name = claim_next_object();
+                if(!name.has_value())
+                    break;
+                t_blueprints.add(create_rootmodule_blueprint(name.value()));
+                m_objects.push_back(name.value());
+            }
+        }
+    }
+}
+
+void misaxx::misa_root_module_base::build_incremental(const misaxx::misa_dispatcher::blueprint_builder &) {
+    size_t objects_in_flight = 0;
+    for(const auto &child : get_node()->get_children()) {
+        if(child->get_worker_status() != misa_worker_status::done)
+            ++objects_in_flight;
+    }
+    const size_t max_objects_in_flight = get_max_objects_in_flight();
+    while(objects_in_flight < max_objects_in_flight) {
+        const auto name = claim_next_object();
+        if(!name.has_value())
+            break;
+        // Creating the blueprint already instantiates the submodule
+        create_rootmodule_blueprint(name.value());
+        m_objects.push_back(name.value());
+        ++objects_in_flight;
+    }
+}
+
+bool misaxx::misa_root_module_base::is_build_complete() const {
+    return m_unclaimed_objects.empty();
+}
+
+std::optional<std::string> misaxx::misa_root_module_base::claim_next_object() {
+    const boost::filesystem::path work_queue_path = misaxx::runtime_properties::get_work_queue_path();
+    if(work_queue_path.empty()) {
+        if(m_unclaimed_objects.empty())
+            return std::nullopt;
+        std::string name = std::move(m_unclaimed_objects.back());
+        m_unclaimed_objects.pop_back();
+        return name;
+    }
+    boost::filesystem::create_directories(work_queue_path);
+    while(!m_unclaimed_objects.empty()) {
+        std::string name = std::move(m_unclaimed_objects.back());
+        m_unclaimed_objects.pop_back();
+        if(misaxx::utils::try_create_lock_file(work_queue_path / (name + ".lock"), misaxx::runtime_properties::get_shard_id())) {
+            misaxx::utils::log_message(misaxx::utils::log_level::info) << "[multiobject_root] Claimed object " << name << " from work queue " << work_queue_path.string();
+            return name;
+        }
     }
+    return std::nullopt;
+}
+
+size_t misaxx::misa_root_module_base::get_max_objects_in_flight() {
+    const size_t max_samples_in_flight = misaxx::runtime_properties::get_max_samples_in_flight();
+    if(max_samples_in_flight > 0)
+        return max_samples_in_flight;
+    // Samples from a work queue are claimed one after another
+    if(!misaxx::runtime_properties::get_work_queue_path().empty())
+        return 1;
+    return 0;
 }
 
 void misaxx::misa_root_module_base::build(const misaxx::misa_dispatcher::blueprint_builder &t_builder) {
@@ -11,6 +11,12 @@
  */
 
 #include <misaxx/core/misa_task.h>
+#include <misaxx/core/misa_cache.h>
+#include <misaxx/core/utils/log.h>
+#include <misaxx/core/runtime/misa_runtime.h>
+#include <algorithm>
+#include <limits>
+#include "src/misaxx/core/runtime/misa_memoization_store.h"
 
 using namespace misaxx;
 
@@ -28,28 +34,103 @@ void misa_task::simulate_work() {
 }
 
 void misa_task::execute_work() {
-    if(misaxx::runtime_properties::is_simulating())
+    if(misaxx::runtime_properties::is_simulating()) {
         simulate_work();
-    else
+        return;
+    }
+
+    misa_memoization_store *store = misa_runtime::instance().get_memoization_store();
+    if(store == nullptr || m_cache_usage->outputs.empty()) {
+        work();
+        return;
+    }
+
+    const std::string fingerprint = store->get_fingerprint(*this, *m_cache_usage);
+    if(fingerprint.empty()) {
+        misaxx::utils::log_message(misaxx::utils::log_level::debug) << "<#> <#> " << *get_node()->get_global_path() << " cannot be memoized, as the fingerprint of an input is unknown";
         work();
+        return;
+    }
+    const bool can_restore = misa_memoization_store::can_restore(*m_cache_usage);
+    if(can_restore && store->restore(fingerprint, *m_cache_usage)) {
+        store->register_outputs(fingerprint, *m_cache_usage);
+        misaxx::utils::log_message(misaxx::utils::log_level::info) << "<#> <#> Restored outputs of " << *get_node()->get_global_path() << " from memoization store (" << fingerprint << ")";
+        return;
+    }
+    work();
+    if(get_node()->get_worker_status() != misa_worker_status::queued_repeat) {
+        // Consumers of the outputs are fingerprinted even if the outputs cannot be stored
+        store->register_outputs(fingerprint, *m_cache_usage);
+        if(can_restore && has_output_attachments()) {
+            misaxx::utils::log_message(misaxx::utils::log_level::debug) << "<#> <#> Outputs of " << *get_node()->get_global_path() << " are not memoized, as they carry attachments";
+        }
+        else if(can_restore) {
+            store->schedule_save(fingerprint, *m_cache_usage);
+        }
+    }
+}
+
+bool misa_task::has_output_attachments() const {
+    return std::any_of(m_cache_usage->outputs.begin(), m_cache_usage->outputs.end(), [](const std::shared_ptr<misa_cache> &cache) {
+        misaxx::utils::readonly_access<misa_cache::attachment_type> access(cache->attachments);
+        return !access.get().empty();
+    });
 }
 
 bool misa_task::is_parallelizeable() const {
     return is_parallelizeable_parameter.query();
 }
 
+size_t misa_task::get_memory_estimate() const {
+    return 0;
+}
+
+double misa_task::get_cost_estimate() const {
+    return 0;
+}
+
+misa_resource_class misa_task::get_resource_class() const {
+    return misa_resource_class::compute;
+}
+
 void misa_task::create_parameters(parameter_list &) {
 }
 
+void misa_task::create_cache_usage(cache_usage &) {
+}
+
+const misa_cache_usage &misa_task::get_cache_usage() const {
+    return *m_cache_usage;
+}
+
 const misa_parameter_builder &misa_task::get_parameters() const {
     return *m_parameter_builder;
 }
 
+void misa_task::parallel_for(size_t t_count, const std::function<void(size_t)> &t_function, size_t t_grain) const {
+    if(t_grain == 0)
+        t_grain = 1;
+    const size_t num_blocks = (t_count + t_grain - 1) / t_grain;
+    if(num_blocks > static_cast<size_t>(std::numeric_limits<int>::max()))
+        throw std::runtime_error("Too many blocks in parallel_for! Increase the grain size.");
+    misa_runtime::instance().parallel_for(static_cast<int>(num_blocks), [&](int t_block) {
+        const size_t end = std::min(t_count, (static_cast<size_t>(t_block) + 1) * t_grain);
+        for(size_t i = static_cast<size_t>(t_block) * t_grain; i < end; ++i) {
+            t_function(i);
+        }
+    });
+}
+
 void misa_task::prepare_work() {
     // Check if we actually need to create parameters
     if(!static_cast<bool>(m_parameter_builder)) {
         m_parameter_builder = std::make_unique<misa_parameter_builder>(*this);
         create_parameters(*m_parameter_builder);
+        m_parameter_builder->resolve_parameters();
+    }
+    if(!static_cast<bool>(m_cache_usage)) {
+        m_cache_usage = std::make_unique<misa_cache_usage>();
+        create_cache_usage(*m_cache_usage);
     }
 }
 
@@ -36,17 +36,6 @@ misaxx::misa_module_info misaxx::module_info() {
     boost_info.set_is_external(true);
     info.add_dependency(std::move(boost_info));
 
-    // External dependency: OpenMP
-    misaxx::misa_module_info openmp_info;
-    openmp_info.set_id("openmp");
-    openmp_info.set_version("4.5");
-    openmp_info.set_name("OpenMP");
-    openmp_info.set_url("https://www.openmp.org/");
-    openmp_info.set_organization("OpenMP ARB");
-    openmp_info.set_citation("Dagum, Leonardo, and Ramesh Menon. \"OpenMP: An industry-standard API for shared-memory programming.\" Computing in Science & Engineering 1 (1998): 46-55.");
-    openmp_info.set_is_external(true);
-    info.add_dependency(std::move(openmp_info));
-
     // External dependency: JSON for modern C++
     misaxx::misa_module_info nlohmann_json_info;
     nlohmann_json_info.set_id("nlohmann-json");
@@ -11,6 +11,7 @@
  */
 
 #include <boost/program_options.hpp>
+#include <misaxx/core/utils/log.h>
 #include <misaxx/core/filesystem/misa_filesystem_empty_importer.h>
 #include <misaxx/core/filesystem/misa_filesystem_directories_importer.h>
 #include <misaxx/core/filesystem/misa_filesystem_json_importer.h>
@@ -50,10 +51,27 @@ misa_cli::cli_result misa_cli::load_from_cli(const int argc, const char **argv)
             ("module-info", "Prints the module module information as serialized JSON")
             ("parameters,p", po::value<std::string>(), "Provides the list of parameters")
             ("threads,t", po::value<int>(), "Sets the number of threads")
+            ("log-level", po::value<std::string>(), "Sets the verbosity of the log (error, warning, info or debug)")
+            ("memory-budget", po::value<int>(), "Limits the estimated memory (in MB) of tasks that work at the same time")
+            ("io-slots", po::value<int>(), "Limits the number of I/O-bound tasks that work at the same time")
+            ("compute-slots", po::value<int>(), "Limits the number of compute-bound tasks that work at the same time")
+            ("batch-duration", po::value<double>(), "Runs small sibling tasks in batches of about this runtime (in ms). 0 disables batching")
+            ("no-task-fusion", "Runs each task in its own job instead of fusing it with its only dependent task")
+            ("cost-history", po::value<std::string>(), "Prioritizes workers using the runtime log of a previous run")
+            ("shard", po::value<std::string>(), "Only processes the samples of shard i/n (e.g. 0/4)")
+            ("work-queue", po::value<std::string>(), "Claims samples one after another from a directory shared with other processes")
+            ("max-samples-in-flight", po::value<int>(), "Limits the number of samples that are processed at the same time. Further samples are started when others finished")
+            ("thread-affinity", po::value<std::string>(), "Pins worker threads to CPUs: compact, scatter or a list of CPUs (e.g. 0,2,4-7)")
+            ("memoization-store", po::value<std::string>(), "Restores outputs of tasks with unchanged parameters and inputs from this directory")
             ("skip", "Requests that already existing results should be used instead of re-calculating them")
             ("write-parameter-schema", po::value<std::string>(), "Writes a parameter schema to the target file")
             ("write-readme", po::value<std::string>(), "Writes a README file to the target file")
+            ("attachment-format", po::value<std::string>(), "Format of the exported attachment files (json, cbor or msgpack)")
+            ("attachment-storage", po::value<std::string>(), "Stores attachments in one file per cache (files) or per sample (sample)")
             ("full-runtime-log", "Writes a comprehensive log containing the runtimes of each tasks into the output directory")
+            ("skip-parameter-schema", "Does not write a parameter schema into the output directory")
+            ("parameter-schema-cache", po::value<std::string>(), "Reuses parameter schemas of previous runs with the same module version and parameter structure from this directory")
+            ("trace", "Writes a Chrome trace (trace.json) of tasks, dispatcher steps and cache accesses into the output directory")
             ("write-worker-graph", "Writes the DAG of workers a misa-workers.dot into the output directory");
 
     po::command_line_parser parser(argc, argv);
@@ -102,13 +120,16 @@ misa_cli::cli_result misa_cli::load_from_cli(const int argc, const char **argv)
             this->set_request_skipping(true);
         }
     }
+    if(vm.count("log-level")) {
+        misaxx::utils::set_log_level(misaxx::utils::log_level_from_string(vm["log-level"].as<std::string>()));
+    }
     if(vm.count("threads")) {
         if(!this->is_simulating()) {
             this->set_num_threads(vm["threads"].as<int>());
         }
         else {
             this->set_num_threads(1);
-            std::cout << "<#> <#> RUNNING IN SIMULATION MODE. This application will run only with 1 thread." << "\n";
+            misaxx::utils::log_message(misaxx::utils::log_level::info) << "<#> <#> RUNNING IN SIMULATION MODE. This application will run only with 1 thread.";
         }
     }
 //    if(vm.count("no-skip")) {
@@ -118,7 +139,7 @@ misa_cli::cli_result misa_cli::load_from_cli(const int argc, const char **argv)
 //    }
     if(vm.count("parameters")) {
         std::string filename = vm["parameters"].as<std::string>();
-        std::cout << "<#> <#> Loading parameters from " << filename << "\n";
+        misaxx::utils::log_message(misaxx::utils::log_level::info) << "<#> <#> Loading parameters from " << filename;
         if(!boost::filesystem::exists(filename))
             throw std::runtime_error("The file " + filename + " does not exist!");
         std::ifstream in { filename };
@@ -139,6 +160,159 @@ misa_cli::cli_result misa_cli::load_from_cli(const int argc, const char **argv)
         schema->declare_optional<int>(1);
         this->set_num_threads(misaxx::parameter_registry:: template get_json<int>({ "runtime", "num-threads" }));
     }
+    if(!vm.count("log-level")) {
+        auto schema = misaxx::parameter_registry::register_parameter({ "runtime", "log-level" });
+        schema->declare_optional<std::string>("info");
+        misaxx::utils::set_log_level(misaxx::utils::log_level_from_string(
+                misaxx::parameter_registry:: template get_json<std::string>({ "runtime", "log-level" })));
+    }
+    if(!this->is_simulating()) {
+        int memory_budget;
+        if(vm.count("memory-budget")) {
+            memory_budget = vm["memory-budget"].as<int>();
+        }
+        else {
+            auto schema = misaxx::parameter_registry::register_parameter({ "runtime", "memory-budget" });
+            schema->declare_optional<int>(0);
+            memory_budget = misaxx::parameter_registry:: template get_json<int>({ "runtime", "memory-budget" });
+        }
+        if(memory_budget < 0)
+            throw std::runtime_error("Invalid memory budget!");
+        this->set_memory_budget(static_cast<size_t>(memory_budget) * 1024 * 1024);
+    }
+    if(!this->is_simulating()) {
+        const std::vector<std::pair<std::string, misaxx::misa_resource_class>> resource_classes {
+                { "io-slots", misaxx::misa_resource_class::io },
+                { "compute-slots", misaxx::misa_resource_class::compute }
+        };
+        for(const auto &kv : resource_classes) {
+            int slots;
+            if(vm.count(kv.first)) {
+                slots = vm[kv.first].as<int>();
+            }
+            else {
+                auto schema = misaxx::parameter_registry::register_parameter({ "runtime", kv.first });
+                schema->declare_optional<int>(0);
+                slots = misaxx::parameter_registry:: template get_json<int>({ "runtime", kv.first });
+            }
+            if(slots < 0)
+                throw std::runtime_error("Invalid number of " + kv.first + "!");
+            this->set_resource_slots(kv.second, static_cast<size_t>(slots));
+        }
+    }
+    if(!this->is_simulating()) {
+        double batch_duration;
+        if(vm.count("batch-duration")) {
+            batch_duration = vm["batch-duration"].as<double>();
+        }
+        else {
+            auto schema = misaxx::parameter_registry::register_parameter({ "runtime", "batch-duration" });
+            schema->declare_optional<double>(5);
+            batch_duration = misaxx::parameter_registry:: template get_json<double>({ "runtime", "batch-duration" });
+        }
+        if(batch_duration < 0)
+            throw std::runtime_error("Invalid batch duration!");
+        this->set_batch_duration(batch_duration);
+    }
+    if(!this->is_simulating()) {
+        if(vm.count("no-task-fusion")) {
+            this->set_task_fusion(false);
+        }
+        else {
+            auto schema = misaxx::parameter_registry::register_parameter({ "runtime", "task-fusion" });
+            schema->declare_optional<bool>(true);
+            this->set_task_fusion(misaxx::parameter_registry::get_json<bool>({ "runtime", "task-fusion" }));
+        }
+    }
+    if(!this->is_simulating()) {
+        if(vm.count("cost-history")) {
+            this->set_cost_history_path(vm["cost-history"].as<std::string>());
+        }
+        else {
+            auto schema = misaxx::parameter_registry::register_parameter({ "runtime", "cost-history" });
+            schema->declare_optional<std::string>("");
+            this->set_cost_history_path(misaxx::parameter_registry:: template get_json<std::string>({ "runtime", "cost-history" }));
+        }
+    }
+    if(!this->is_simulating()) {
+        std::string shard;
+        if(vm.count("shard")) {
+            shard = vm["shard"].as<std::string>();
+        }
+        else {
+            auto schema = misaxx::parameter_registry::register_parameter({ "runtime", "shard" });
+            schema->declare_optional<std::string>("");
+            shard = misaxx::parameter_registry:: template get_json<std::string>({ "runtime", "shard" });
+        }
+        if(!shard.empty()) {
+            const auto separator = shard.find('/');
+            if(separator == std::string::npos)
+                throw std::runtime_error("Invalid shard " + shard + "! Expected i/n.");
+            this->set_shard(std::stoi(shard.substr(0, separator)), std::stoi(shard.substr(separator + 1)));
+        }
+
+        if(vm.count("work-queue")) {
+            this->set_work_queue_path(vm["work-queue"].as<std::string>());
+        }
+        else {
+            auto schema = misaxx::parameter_registry::register_parameter({ "runtime", "work-queue" });
+            schema->declare_optional<std::string>("");
+            this->set_work_queue_path(misaxx::parameter_registry:: template get_json<std::string>({ "runtime", "work-queue" }));
+        }
+
+        int max_samples_in_flight;
+        if(vm.count("max-samples-in-flight")) {
+            max_samples_in_flight = vm["max-samples-in-flight"].as<int>();
+        }
+        else {
+            auto schema = misaxx::parameter_registry::register_parameter({ "runtime", "max-samples-in-flight" });
+            schema->declare_optional<int>(0);
+            max_samples_in_flight = misaxx::parameter_registry:: template get_json<int>({ "runtime", "max-samples-in-flight" });
+        }
+        if(max_samples_in_flight < 0)
+            throw std::runtime_error("Invalid number of samples in flight!");
+        this->set_max_samples_in_flight(static_cast<size_t>(max_samples_in_flight));
+    }
+    if(!this->is_simulating()) {
+        if(vm.count("thread-affinity")) {
+            this->set_thread_affinity(vm["thread-affinity"].as<std::string>());
+        }
+        else {
+            auto schema = misaxx::parameter_registry::register_parameter({ "runtime", "thread-affinity" });
+            schema->declare_optional<std::string>("");
+            this->set_thread_affinity(misaxx::parameter_registry:: template get_json<std::string>({ "runtime", "thread-affinity" }));
+        }
+    }
+    if(!this->is_simulating()) {
+        if(vm.count("attachment-format")) {
+            this->set_attachment_format(vm["attachment-format"].as<std::string>());
+        }
+        else {
+            auto schema = misaxx::parameter_registry::register_parameter({ "runtime", "attachment-format" });
+            schema->declare_optional<std::string>("json");
+            this->set_attachment_format(misaxx::parameter_registry:: template get_json<std::string>({ "runtime", "attachment-format" }));
+        }
+    }
+    if(!this->is_simulating()) {
+        if(vm.count("attachment-storage")) {
+            this->set_attachment_storage(vm["attachment-storage"].as<std::string>());
+        }
+        else {
+            auto schema = misaxx::parameter_registry::register_parameter({ "runtime", "attachment-storage" });
+            schema->declare_optional<std::string>("files");
+            this->set_attachment_storage(misaxx::parameter_registry:: template get_json<std::string>({ "runtime", "attachment-storage" }));
+        }
+    }
+    if(!this->is_simulating()) {
+        if(vm.count("memoization-store")) {
+            this->set_memoization_store_path(vm["memoization-store"].as<std::string>());
+        }
+        else {
+            auto schema = misaxx::parameter_registry::register_parameter({ "runtime", "memoization-store" });
+            schema->declare_optional<std::string>("");
+            this->set_memoization_store_path(misaxx::parameter_registry:: template get_json<std::string>({ "runtime", "memoization-store" }));
+        }
+    }
     if(!vm.count("skip") && !this->requests_skipping()) {
         auto schema = misaxx::parameter_registry::register_parameter({ "runtime", "request-skipping" });
         schema->declare_optional<bool>(false);
@@ -158,16 +332,40 @@ misa_cli::cli_result misa_cli::load_from_cli(const int argc, const char **argv)
             schema->declare_optional<bool>(false);
             this->set_enable_full_runtime_log(misaxx::parameter_registry::get_json<bool>({ "runtime", "full-runtime-log" }));
         }
+        if(vm.count("skip-parameter-schema")) {
+            this->set_skip_parameter_schema(true);
+        }
+        else {
+            auto schema = misaxx::parameter_registry::register_parameter({ "runtime", "skip-parameter-schema" });
+            schema->declare_optional<bool>(false);
+            this->set_skip_parameter_schema(misaxx::parameter_registry::get_json<bool>({ "runtime", "skip-parameter-schema" }));
+        }
+        if(vm.count("parameter-schema-cache")) {
+            this->set_parameter_schema_cache_path(vm["parameter-schema-cache"].as<std::string>());
+        }
+        else {
+            auto schema = misaxx::parameter_registry::register_parameter({ "runtime", "parameter-schema-cache" });
+            schema->declare_optional<std::string>("");
+            this->set_parameter_schema_cache_path(misaxx::parameter_registry::get_json<std::string>({ "runtime", "parameter-schema-cache" }));
+        }
+        if(vm.count("trace")) {
+            this->set_write_trace(true);
+        }
+        else {
+            auto schema = misaxx::parameter_registry::register_parameter({ "runtime", "trace" });
+            schema->declare_optional<bool>(false);
+            this->set_write_trace(misaxx::parameter_registry::get_json<bool>({ "runtime", "trace" }));
+        }
     }
 
     return misa_cli::cli_result::continue_with_workload;
 }
 
 misa_cli::cli_result misa_cli::run() {
-    std::cout << "<#> <#> Starting run with " << this->get_num_threads() << " threads" << "\n";
+    misaxx::utils::log_message(misaxx::utils::log_level::info) << "<#> <#> Starting run with " << this->get_num_threads() << " threads";
 
     if(this->is_simulating()) {
-        std::cout << "<#> <#> RUNNING IN SIMULATION MODE. This will build a parameter schema, but no real work is done!" << "\n";
+        misaxx::utils::log_message(misaxx::utils::log_level::info) << "<#> <#> RUNNING IN SIMULATION MODE. This will build a parameter schema, but no real work is done!";
     }
 
     // Call the runtime's prepare & run function
@@ -176,7 +374,7 @@ misa_cli::cli_result misa_cli::run() {
     // Build schema
     if(this->is_simulating()) {
         if(!m_pimpl->m_parameter_schema_path.empty()) {
-            std::cout << "<#> <#> Writing parameter schema to " << m_pimpl->m_parameter_schema_path.string() << "\n";
+            misaxx::utils::log_message(misaxx::utils::log_level::info) << "<#> <#> Writing parameter schema to " << m_pimpl->m_parameter_schema_path.string();
             nlohmann::json j;
             this->get_schema_builder()->to_json(j);
             std::ofstream w;
@@ -185,13 +383,14 @@ misa_cli::cli_result misa_cli::run() {
         }
 
         if(!m_pimpl->m_readme_path.empty()) {
-            std::cout << "<#> <#> Writing README to " << m_pimpl->m_readme_path.string() << "\n";
+            misaxx::utils::log_message(misaxx::utils::log_level::info) << "<#> <#> Writing README to " << m_pimpl->m_readme_path.string();
             nlohmann::json j;
             this->get_schema_builder()->to_json(j);
             build_readme(j, m_pimpl->m_readme_path);
         }
     }
 
+    misaxx::utils::flush_log();
     return misa_cli::cli_result::ok;
 }
 
@@ -199,10 +398,17 @@ int misa_cli::prepare_and_run(const int argc, const char **argv) {
     const misa_cli::cli_result ret = load_from_cli(argc, argv);
     switch(ret) {
         case misa_cli::cli_result::continue_with_workload:
-            if(run() == misa_cli::cli_result ::ok)
-                return 0;
-            else
-                return 1;
+            try {
+                if(run() == misa_cli::cli_result ::ok)
+                    return 0;
+                else
+                    return 1;
+            }
+            catch(...) {
+                // Pending log lines explain what happened before the error
+                misaxx::utils::flush_log();
+                throw;
+            }
         case misa_cli::cli_result::no_workload:
             return 0;
         case misa_cli::cli_result::error:
@@ -0,0 +1,243 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#include <typeinfo>
+#include <algorithm>
+#include <vector>
+#include <boost/filesystem/operations.hpp>
+#include <misaxx/core/misa_task.h>
+#include <misaxx/core/utils/log.h>
+#include <misaxx/core/runtime/misa_parameter_registry.h>
+#include <misaxx/core/runtime/misa_runtime_properties.h>
+#include "misa_memoization_store.h"
+#include "misa_sha256.h"
+
+using namespace misaxx;
+
+namespace {
+
+    /**
+     * Hashes the content of a file or all files within a directory
+     * @return false if the location does not exist
+     */
+    bool hash_location(misa_sha256 &t_hash, const boost::filesystem::path &t_path) {
+        if(boost::filesystem::is_regular_file(t_path)) {
+            t_hash.update_file(t_path);
+            return true;
+        }
+        else if(boost::filesystem::is_directory(t_path)) {
+            std::vector<boost::filesystem::path> files;
+            for(const auto &entry : boost::filesystem::recursive_directory_iterator(t_path)) {
+                if(boost::filesystem::is_regular_file(entry.path()))
+                    files.push_back(entry.path());
+            }
+            std::sort(files.begin(), files.end());
+            for(const auto &file : files) {
+                t_hash.update(file.lexically_relative(t_path).generic_string());
+                t_hash.update_file(file);
+            }
+            return true;
+        }
+        else {
+            return false;
+        }
+    }
+
+    /**
+     * Returns the location of the data within a cache
+     */
+    boost::filesystem::path get_data_location(const misa_cache &t_cache) {
+        const boost::filesystem::path unique_location = t_cache.get_unique_location();
+        return unique_location.empty() ? t_cache.get_location() : unique_location;
+    }
+
+    /**
+     * Returns the file or directory that contains the data of an imported cache.
+     * Caches within a file (e.g. OME TIFF planes) have no file of their own. Their whole location is used instead.
+     */
+    boost::filesystem::path get_content_location(const misa_cache &t_cache) {
+        const boost::filesystem::path location = get_data_location(t_cache);
+        return boost::filesystem::exists(location) ? location : t_cache.get_location();
+    }
+
+    bool is_imported(const misa_cache &t_cache) {
+        const boost::filesystem::path internal_location = t_cache.get_internal_location();
+        return internal_location.begin() != internal_location.end() && internal_location.begin()->string() == "imported";
+    }
+}
+
+misa_memoization_store::misa_memoization_store(boost::filesystem::path t_path) : m_path(std::move(t_path)) {
+
+}
+
+std::string misa_memoization_store::get_fingerprint(const misa_task &t_task, const misa_cache_usage &t_caches) {
+    misa_sha256 hash;
+
+    // Implementation & versions
+    hash.update(typeid(t_task).name());
+    hash.update(nlohmann::json(misaxx::runtime_properties::get_module_info()).dump());
+
+    // Parameters of the dispatchers along the algorithm path and all parameters below the task
+    const nlohmann::json &parameters = misaxx::parameter_registry::get_parameter_json();
+    const nlohmann::json *current = &parameters;
+    for(const std::string &key : t_task.get_node()->get_algorithm_path()->get_path()) {
+        hash.update(key);
+        if(!current->is_object() || current->find(key) == current->end()) {
+            current = nullptr;
+            break;
+        }
+        current = &current->at(key);
+        if(current->is_object()) {
+            for(const auto &kv : current->items()) {
+                if(!kv.value().is_object()) {
+                    hash.update(kv.key());
+                    hash.update(kv.value().dump());
+                }
+            }
+        }
+    }
+    if(current != nullptr) {
+        hash.update(current->dump());
+    }
+
+    // Sample parameters
+    const nlohmann::json *sample = &parameters;
+    for(const std::string &key : t_task.get_node()->get_sample_path()->get_path()) {
+        if(!sample->is_object() || sample->find(key) == sample->end()) {
+            sample = nullptr;
+            break;
+        }
+        sample = &sample->at(key);
+    }
+    if(sample != nullptr) {
+        hash.update(sample->dump());
+    }
+
+    // Input data
+    for(const auto &cache : t_caches.inputs) {
+        const std::string location = get_data_location(*cache).string();
+        std::string input_fingerprint;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_fingerprints.find(location);
+            if(it != m_fingerprints.end()) {
+                input_fingerprint = it->second;
+            }
+            else if(!is_imported(*cache)) {
+                // Written by a task that has no fingerprint
+                return "";
+            }
+        }
+        if(input_fingerprint.empty()) {
+            // Imported data does not change during the run. Only hash it once.
+            if(!is_imported(*cache))
+                return "";
+            const std::string content_location = get_content_location(*cache).string();
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto it = m_fingerprints.find(content_location);
+                if(it != m_fingerprints.end()) {
+                    input_fingerprint = it->second;
+                }
+            }
+            if(input_fingerprint.empty()) {
+                misa_sha256 content_hash;
+                if(!hash_location(content_hash, content_location))
+                    return "";
+                input_fingerprint = content_hash.to_string();
+            }
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_fingerprints[content_location] = input_fingerprint;
+            m_fingerprints[location] = input_fingerprint;
+        }
+        hash.update(input_fingerprint);
+    }
+    hash.update(std::to_string(t_caches.outputs.size()));
+
+    return hash.to_string();
+}
+
+void misa_memoization_store::register_outputs(const std::string &t_fingerprint, const misa_cache_usage &t_caches) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for(size_t i = 0; i < t_caches.outputs.size(); ++i) {
+        const std::string output_fingerprint = t_fingerprint + "/" + std::to_string(i);
+        auto inserted = m_fingerprints.emplace(get_data_location(*t_caches.outputs[i]).string(), output_fingerprint);
+        if(!inserted.second && inserted.first->second != output_fingerprint) {
+            inserted.first->second.clear();
+        }
+    }
+}
+
+bool misa_memoization_store::can_restore(const misa_cache_usage &t_caches) {
+    return std::all_of(t_caches.outputs.begin(), t_caches.outputs.end(), [](const auto &cache) {
+        return cache->can_restore();
+    });
+}
+
+bool misa_memoization_store::restore(const std::string &t_fingerprint, const misa_cache_usage &t_caches) const {
+    const boost::filesystem::path entry_path = m_path / t_fingerprint;
+    if(!boost::filesystem::is_directory(entry_path))
+        return false;
+    for(size_t i = 0; i < t_caches.outputs.size(); ++i) {
+        if(!boost::filesystem::is_regular_file(entry_path / std::to_string(i)))
+            return false;
+    }
+    for(size_t i = 0; i < t_caches.outputs.size(); ++i) {
+        t_caches.outputs[i]->restore(entry_path / std::to_string(i));
+    }
+    return true;
+}
+
+void misa_memoization_store::schedule_save(const std::string &t_fingerprint, const misa_cache_usage &t_caches) {
+    scheduled_entry entry;
+    entry.fingerprint = t_fingerprint;
+    entry.caches = t_caches.outputs;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_scheduled.push_back(std::move(entry));
+}
+
+void misa_memoization_store::save_scheduled() {
+    std::vector<scheduled_entry> entries;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::swap(entries, m_scheduled);
+    }
+    if(!entries.empty()) {
+        misaxx::utils::log_message(misaxx::utils::log_level::info) << "<#> <#> Saving outputs of " << entries.size() << " tasks into the memoization store " << m_path.string();
+    }
+    boost::filesystem::create_directories(m_path);
+    for(const scheduled_entry &entry : entries) {
+        const boost::filesystem::path entry_path = m_path / entry.fingerprint;
+        if(boost::filesystem::exists(entry_path))
+            continue;
+
+        // Write into a temporary directory first, so other processes never see incomplete entries
+        const boost::filesystem::path tmp_path = m_path / (entry.fingerprint + boost::filesystem::unique_path(".tmp-%%%%-%%%%").string());
+        boost::filesystem::create_directories(tmp_path);
+        bool complete = true;
+        for(size_t i = 0; i < entry.caches.size() && complete; ++i) {
+            complete = entry.caches[i]->save(tmp_path / std::to_string(i));
+        }
+        boost::system::error_code ec;
+        if(!complete) {
+            misaxx::utils::log_message(misaxx::utils::log_level::info) << "<#> <#> Outputs for " << entry.fingerprint << " cannot be memoized, as they do not exist in the filesystem";
+            boost::filesystem::remove_all(tmp_path, ec);
+            continue;
+        }
+
+        boost::filesystem::rename(tmp_path, entry_path, ec);
+        if(ec) {
+            // Another process stored the same outputs in the meantime
+            boost::filesystem::remove_all(tmp_path, ec);
+        }
+    }
+}
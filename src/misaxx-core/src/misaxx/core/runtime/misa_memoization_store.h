@@ -0,0 +1,103 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <boost/filesystem/path.hpp>
+#include <misaxx/core/misa_cache_usage.h>
+
+namespace misaxx {
+
+    struct misa_task;
+
+    /**
+     * Content-addressed store for the outputs of tasks.
+     * Each entry is a directory named by the fingerprint of the task. It contains a file for each output cache (see misa_cache::save()).
+     * The fingerprints of task outputs are chained through the task graph: a task that consumes the output of another
+     * task uses the fingerprint of this task instead of reading the data.
+     * Thread-safe.
+     */
+    class misa_memoization_store {
+    public:
+
+        explicit misa_memoization_store(boost::filesystem::path t_path);
+
+        /**
+         * Calculates the fingerprint of a task from its type, its parameters, the module versions
+         * and the fingerprints of its input caches.
+         * Inputs written by other tasks have the fingerprints assigned by register_outputs().
+         * Imported inputs are identified by their content.
+         * @param t_task
+         * @param t_caches
+         * @return The fingerprint or an empty string if the fingerprint of an input is unknown
+         */
+        std::string get_fingerprint(const misa_task &t_task, const misa_cache_usage &t_caches);
+
+        /**
+         * Assigns fingerprints to the output caches of a task
+         * Caches that are written by multiple tasks have no fingerprint.
+         * @param t_fingerprint Fingerprint of the task
+         * @param t_caches
+         */
+        void register_outputs(const std::string &t_fingerprint, const misa_cache_usage &t_caches);
+
+        /**
+         * Returns true if all output caches can be restored from the store
+         * @param t_caches
+         * @return
+         */
+        static bool can_restore(const misa_cache_usage &t_caches);
+
+        /**
+         * Loads the stored outputs into the output caches
+         * @param t_fingerprint
+         * @param t_caches
+         * @return false if the store does not contain the fingerprint
+         */
+        bool restore(const std::string &t_fingerprint, const misa_cache_usage &t_caches) const;
+
+        /**
+         * Marks the outputs to be copied into the store by save_scheduled()
+         * @param t_fingerprint
+         * @param t_caches
+         */
+        void schedule_save(const std::string &t_fingerprint, const misa_cache_usage &t_caches);
+
+        /**
+         * Saves the outputs marked by schedule_save() into the store.
+         * Must be called after the output caches were postprocessed, as their files are incomplete before.
+         */
+        void save_scheduled();
+
+    private:
+
+        struct scheduled_entry {
+            std::string fingerprint;
+            std::vector<std::shared_ptr<misa_cache>> caches;
+        };
+
+        boost::filesystem::path m_path;
+        std::mutex m_mutex;
+
+        /**
+         * Fingerprints of the data locations of caches
+         * An empty fingerprint marks data that cannot be fingerprinted.
+         */
+        std::unordered_map<std::string, std::string> m_fingerprints;
+
+        std::vector<scheduled_entry> m_scheduled;
+    };
+}
@@ -23,6 +23,10 @@ nlohmann::json misaxx::parameter_registry::get_json_raw(const std::vector<std::s
     return misa_runtime::instance().get_parameter_value(t_path);
 }
 
+const nlohmann::json *misaxx::parameter_registry::find_json_raw(const std::vector<std::string> &t_path) {
+    return misa_runtime::instance().find_parameter_value(t_path);
+}
+
 std::shared_ptr<misa_json_schema_property> misaxx::parameter_registry::get_schema_builder() {
     return misa_runtime::instance().get_schema_builder();
 }
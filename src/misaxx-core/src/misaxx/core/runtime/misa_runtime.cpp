@@ -10,19 +10,22 @@
  * See the LICENSE file provided with this code for the full license.
  */
 
-#include <misaxx/core/runtime/misa_runtime.h>
-#include <misaxx/core/runtime/misa_runtime_log.h>
 #include <misaxx/core/misa_module_interface.h>
 #include <misaxx/core/filesystem/misa_filesystem_empty_importer.h>
 #include <misaxx/core/filesystem/misa_filesystem_directories_importer.h>
 #include <misaxx/core/filesystem/misa_filesystem_json_importer.h>
 #include <iomanip>
 #include <misaxx/core/utils/manual_stopwatch.h>
-#include <omp.h>
 #include <misaxx/core/utils/string.h>
-#include <misaxx/core/misa_cached_data.h>
+#include <misaxx/core/utils/filesystem.h>
+#include <misaxx/core/utils/trace.h>
+#include <misaxx/core/utils/metrics.h>
+#include <misaxx/core/utils/thread_affinity.h>
 #include <misaxx/core/misa_worker.h>
 #include <misaxx/core/misa_dispatcher.h>
+#include <algorithm>
+#include "misa_runtime_impl.h"
+#include "misa_sha256.h"
 
 using namespace misaxx;
 
@@ -122,121 +125,82 @@ namespace {
 
         sw << "}\n";
     }
-}
-
-namespace misaxx {
-    struct misa_runtime_impl {
-    public:
-
-        misa_module_info m_module_info;
-
-        std::shared_ptr<misa_work_node> m_root;
-
-        std::shared_ptr<misa_work_node> m_schema_root;
-
-        std::unordered_set<std::shared_ptr<misa_cache>> m_registered_caches;
-
-        /**
-         * List of nodes that are not completed and need to be watched
-         */
-        std::vector<misa_work_node *> m_nodes_todo;
-        /**
-         * List of nodes for fast lookup of unknown nodes
-         */
-        std::unordered_set<misa_work_node *> m_nodes_todo_lookup;
-
-        // Variables are protected and will be set by the inheriting runtime
-
-        bool m_is_simulating = false;
-
-        /**
-         * If true, tasks are requested to skip if the results already exist
-         */
-        bool m_requests_skipping = false;
-
-        /**
-       * Number of threads used by the runtime.
-       * If the number is 1, the application will run in the current thread.
-       */
-        int m_num_threads = 1;
-
-        /**
-         * If true, write attachments
-         */
-        bool m_write_attachments = true;
-
-        /**
-         * If true, write only attachments with user-generated data
-         * Otherwise, also writes "empty" attachments (containing description storage and location)
-         */
-        bool m_lazy_write_attachments = true;
 
-        /**
-         * If true, log the start and stop times of each worker
-         */
-        bool m_write_full_runtime_log = false;
-
-        /**
-         * If true, create a *.dot graph of the workers
-         */
-        bool m_create_worker_graph = false;
-
-        /**
-         * Runtime log
-         */
-        misa_runtime_log m_runtime_log;
-
-        /**
-         * Parameters for the workers
-         */
-        nlohmann::json m_parameters;
-
-        /**
-         * Used to create a configuration schema
-         */
-        std::shared_ptr<misa_json_schema_property> m_parameter_schema_builder;
-
-        misa_runtime_impl();
-
-        void run();
+    /**
+     * Key of a parameter in misa_runtime_impl::m_parameter_index (e.g. /algorithm/threshold)
+     * @param t_path
+     * @return
+     */
+    std::string get_parameter_key(const std::vector<std::string> &t_path) {
+        std::string key;
+        for (const std::string &segment : t_path) {
+            key += '/';
+            key += segment;
+        }
+        return key;
+    }
 
-        bool is_running() {
-            return !m_nodes_todo.empty();
+    /**
+     * Looks up the parameters that are described by a JSON schema
+     * @param t_schema JSON schema of the parameters
+     * @param t_parameters The parameters. Null if they do not exist.
+     * @param t_key Key of the parameters
+     * @param t_required If the parameters are required by their parent
+     * @param t_index Parameters by their key
+     * @param t_missing Keys of required parameters that do not exist
+     */
+    void index_parameters(const nlohmann::json &t_schema, const nlohmann::json *t_parameters, const std::string &t_key, bool t_required,
+                          std::unordered_map<std::string, const nlohmann::json *> &t_index, std::vector<std::string> &t_missing) {
+        // Serialized objects are values, even if they have properties
+        const auto properties = t_schema.find("properties");
+        const bool is_value = properties == t_schema.end() || t_schema.find("misa:serialization-id") != t_schema.end();
+
+        if (t_parameters == nullptr) {
+            if (is_value) {
+                if (t_required && t_schema.find("default") == t_schema.end()) {
+                    t_missing.push_back(t_key);
+                }
+                return;
+            }
         }
-        
-        misa_filesystem &get_filesystem() {
-            if(!static_cast<bool>(m_root))
-                throw std::runtime_error("No root module set!");
-            return m_root->get_or_create_instance()->get_module()->filesystem;
+        else {
+            t_index[t_key] = t_parameters;
         }
-        
-    private:
-
-        size_t m_known_nodes_count = 0;
-
-        size_t m_finished_nodes_count = 0;
-
-        size_t m_last_waiting_announcement = 0;
-
-        size_t m_last_rejecting_announcement = 0;
-
-        bool m_tree_complete = false;
-
-        void run_single_threaded();
 
-        void run_parallel();
-
-        void progress(const std::string &t_text);
-
-        void progress(const misa_work_node &t_node, const std::string &t_text);
-
-        void postprocess_caches();
+        if (is_value) {
+            // Templates are applied to all existing keys (e.g. the samples)
+            const auto children_template = t_schema.find("additionalProperties");
+            if (children_template != t_schema.end() && t_parameters->is_object()) {
+                for (auto it = t_parameters->begin(); it != t_parameters->end(); ++it) {
+                    index_parameters(*children_template, &it.value(), t_key + "/" + it.key(), false, t_index, t_missing);
+                }
+            }
+            return;
+        }
 
-        void postprocess_cache_attachments();
+        std::unordered_set<std::string> required;
+        const auto required_properties = t_schema.find("required");
+        if (required_properties != t_schema.end()) {
+            for (const auto &name : *required_properties) {
+                required.insert(name.get<std::string>());
+            }
+        }
 
-        void postprocess_parameter_schema();
-    };
+        // Missing subtrees are looked at, too. They might contain required parameters.
+        for (auto it = properties->begin(); it != properties->end(); ++it) {
+            const nlohmann::json *child = nullptr;
+            if (t_parameters != nullptr && t_parameters->is_object()) {
+                const auto child_it = t_parameters->find(it.key());
+                if (child_it != t_parameters->end()) {
+                    child = &child_it.value();
+                }
+            }
+            index_parameters(it.value(), child, t_key + "/" + it.key(), required.count(it.key()) > 0, t_index, t_missing);
+        }
+    }
+}
 
+namespace misaxx {
     misa_runtime_impl::misa_runtime_impl() : m_parameter_schema_builder(std::make_shared<misa_json_schema_property>()) {
 
     }
@@ -257,20 +221,43 @@ namespace misaxx {
         // Note: misa_filesystem is a shared_ptr-like object
         m_schema_root->get_or_create_instance()->get_module()->filesystem = get_filesystem();
 
+        // Missing parameters are reported before any work is done
+        m_parameter_index.clear();
+        if (!m_is_simulating) {
+            build_parameter_schema();
+            resolve_parameters();
+        }
+
+        // Load runtimes of a previous run to prioritize long paths
+        if (!m_is_simulating && !m_cost_history_path.empty()) {
+            misaxx::utils::log_message(misaxx::utils::log_level::info) << "<#> <#> Loading runtime history from " << m_cost_history_path;
+            m_cost_history.load(m_cost_history_path);
+        }
+
+        m_memoization_store.reset();
+        if (!m_is_simulating && !m_memoization_store_path.empty()) {
+            m_memoization_store = std::make_unique<misa_memoization_store>(m_memoization_store_path);
+        }
+
         // Clear separation between schema space and main space
         if(!m_is_simulating) {
-            m_nodes_todo.push_back(m_root.get());
-            m_nodes_todo_lookup.insert(m_root.get());
+            enqueue(m_root.get());
+            push_ready(m_root.get());
         }
         else {
-            m_nodes_todo.push_back(m_schema_root.get());
-            m_nodes_todo_lookup.insert(m_schema_root.get());
+            enqueue(m_schema_root.get());
+            push_ready(m_schema_root.get());
         }
 
-        ++m_known_nodes_count;
-
         const bool enable_threading = m_num_threads > 1 && !m_is_simulating;
 
+        if (m_write_trace && !m_is_simulating) {
+            misaxx::utils::set_tracing(true);
+        }
+        if (!m_is_simulating) {
+            misaxx::utils::reset_metrics();
+        }
+
         if (!m_write_full_runtime_log) {
             for (int thread = 0; thread < m_num_threads; ++thread) {
                 m_runtime_log.start(thread, "Undefined workload");
@@ -291,6 +278,10 @@ namespace misaxx {
         // Postprocessing steps
         stopwatch.new_operation("Postprocessing");
         postprocess_caches();
+        if (m_memoization_store) {
+            // Outputs are only complete after postprocessing
+            m_memoization_store->save_scheduled();
+        }
         postprocess_cache_attachments();
         if (m_is_simulating) {
             postprocess_parameter_schema();
@@ -300,478 +291,1033 @@ namespace misaxx {
                 boost::filesystem::create_directories(get_filesystem().exported->external_path());
             }
 
+            // Write the performance counters
+            {
+                const auto metrics_path = get_filesystem().exported->external_path() / "runtime-metrics.json";
+                misaxx::utils::log_message(misaxx::utils::log_level::info) << "<#> <#> Writing runtime metrics to " << metrics_path.string();
+                nlohmann::json counters;
+                for (const auto &kv : misaxx::utils::get_metrics()) {
+                    // Counters of different shards are merged into the same file
+                    counters[is_sharded() ? get_shard_id() + "/" + kv.first : kv.first] = kv.second;
+                }
+                nlohmann::json j;
+                j["counters"] = std::move(counters);
+                write_output_json(metrics_path, std::move(j));
+            }
+
+            // Write the trace. Shards write into separate files.
+            if (misaxx::utils::is_tracing()) {
+                const auto trace_path = get_filesystem().exported->external_path() /
+                        (is_sharded() ? "trace-" + get_shard_id() + ".json" : std::string("trace.json"));
+                misaxx::utils::log_message(misaxx::utils::log_level::info) << "<#> <#> Writing trace to " << trace_path.string();
+                misaxx::utils::set_tracing(false);
+                misaxx::utils::write_trace(trace_path);
+            }
+
             const auto parameters_path = get_filesystem().exported->external_path() / "parameters.json";
             const auto module_info_path = get_filesystem().exported->external_path() / "misa-module-info.json";
 
             // Write the parameter file
-            std::cout << "<#> <#> Writing parameters to " << parameters_path << "\n";
-            std::ofstream writer;
-            writer.open(parameters_path.string());
-            writer << std::setw(4) << m_parameters;
-            writer.close();
+            misaxx::utils::log_message(misaxx::utils::log_level::info) << "<#> <#> Writing parameters to " << parameters_path;
+            write_output_json(parameters_path, m_parameters);
 
             // Write module info
-            std::cout << "<#> <#> Writing module info to " << module_info_path << "\n";
-            writer.open(module_info_path.string());
-            writer << std::setw(4) << nlohmann::json(m_module_info);
-            writer.close();
+            misaxx::utils::log_message(misaxx::utils::log_level::info) << "<#> <#> Writing module info to " << module_info_path;
+            write_output_json(module_info_path, nlohmann::json(m_module_info));
         }
         if(m_create_worker_graph) {
-            std::cout << "<#> <#> Writing worker graph as DOT file ... " << "\n";
+            misaxx::utils::log_message(misaxx::utils::log_level::info) << "<#> <#> Writing worker graph as DOT file ... ";
             write_workers_as_graph(m_root, get_filesystem().exported->external_path() / "misa-workers.dot");
         }
         if (!m_is_simulating) {
-            std::cout << "<#> <#> Building parameter schema for results folder ... " << "\n";
-
-            // Write the parameter schema
-            m_is_simulating = true;
-
-            // Clear everything
-            m_nodes_todo.clear();
-            m_nodes_todo_lookup.clear();
-            m_known_nodes_count = 0;
-            m_parameter_schema_builder = std::make_shared<misa_json_schema_property>();
-            m_finished_nodes_count = 0;
-            m_tree_complete = false;
-
             // Set output paths
             const auto runtime_log_output_path =  get_filesystem().exported->external_path() / "runtime-log.json";
             const auto output_path =  get_filesystem().exported->external_path() / "parameter-schema.json";
 
-            // Push the schema root into the tree
-            m_nodes_todo.push_back(m_schema_root.get());
-            m_nodes_todo_lookup.insert(m_schema_root.get());
-            ++m_known_nodes_count;
-
-            // Run the parameter schema workload
-            run_single_threaded();
-
-            postprocess_parameter_schema();
-
-            {
-                std::cout << "<#> <#> Writing parameter schema to " << output_path.string() << "\n";
-                nlohmann::json j;
-                m_parameter_schema_builder->to_json(j);
-                std::ofstream out;
-                out.open(output_path.string());
-                out << std::setw(4) << j;
-                out.close();
+            if (m_skip_parameter_schema) {
+                misaxx::utils::log_message(misaxx::utils::log_level::info) << "<#> <#> Skipping parameter schema for results folder";
+            } else {
+                misaxx::utils::log_message(misaxx::utils::log_level::info) << "<#> <#> Writing parameter schema to " << output_path.string();
+                write_output_json(output_path, std::move(m_parameter_schema));
             }
 
-            m_is_simulating = false;
-
             // Write the runtime log
             {
-                std::cout << "<#> <#> Writing runtime log to " << runtime_log_output_path.string() << "\n";
+                misaxx::utils::log_message(misaxx::utils::log_level::info) << "<#> <#> Writing runtime log to " << runtime_log_output_path.string();
                 nlohmann::json j;
                 m_runtime_log.to_json(j);
-                std::ofstream out;
-                out.open(runtime_log_output_path.string());
-                out << std::setw(4) << j;
-                out.close();
+                if (is_sharded()) {
+                    // Threads of different shards are merged into the same log
+                    nlohmann::json entries;
+                    for (const auto &kv : j["entries"].items()) {
+                        entries[get_shard_id() + "/" + kv.key()] = kv.value();
+                    }
+                    j["entries"] = std::move(entries);
+                }
+                write_output_json(runtime_log_output_path, std::move(j));
             }
         }
 
         stopwatch.stop();
     }
 
-    void misa_runtime_impl::progress(const std::string &t_text) {
+    void misa_runtime_impl::build_parameter_schema() {
+        boost::filesystem::path cached_path;
+        if (!m_parameter_schema_cache_path.empty()) {
+            cached_path = m_parameter_schema_cache_path / (get_parameter_schema_key() + ".json");
+            if (boost::filesystem::exists(cached_path)) {
+                misaxx::utils::log_message(misaxx::utils::log_level::info) << "<#> <#> Reusing parameter schema " << cached_path.string();
+                std::ifstream in;
+                in.open(cached_path.string());
+                in >> m_parameter_schema;
+                in.close();
+                return;
+            }
+        }
+
+        misaxx::utils::log_message(misaxx::utils::log_level::info) << "<#> <#> Building parameter schema ... ";
+
+        // The schema workload must not touch the samples, caches and parameters of the actual workload
+        const std::shared_ptr<misa_json_schema_property> parameter_schema_builder = m_parameter_schema_builder;
+        std::unordered_set<std::shared_ptr<misa_cache>> registered_caches;
+        std::swap(registered_caches, m_registered_caches);
+        m_parameter_schema_builder = std::make_shared<misa_json_schema_property>();
+        m_schema_root->get_or_create_instance()->get_module()->filesystem = misa_filesystem_empty_importer().import();
+
+        m_is_simulating = true;
+        reset_scheduler();
+
+        // Push the schema root into the tree
+        enqueue(m_schema_root.get());
+        push_ready(m_schema_root.get());
+
+        // Run the parameter schema workload
+        run_single_threaded();
+
+        postprocess_parameter_schema();
+
+        m_parameter_schema = nlohmann::json {};
+        m_parameter_schema_builder->to_json(m_parameter_schema);
+
+        m_is_simulating = false;
+        reset_scheduler();
+        m_parameter_schema_builder = parameter_schema_builder;
+        m_registered_caches = std::move(registered_caches);
+
+        if (!cached_path.empty()) {
+            // Other processes might read the cache at the same time
+            misaxx::utils::log_message(misaxx::utils::log_level::info) << "<#> <#> Caching parameter schema as " << cached_path.string();
+            boost::filesystem::create_directories(m_parameter_schema_cache_path);
+            const auto tmp_path = cached_path.string() + "." + boost::filesystem::unique_path().string();
+            std::ofstream out;
+            out.open(tmp_path);
+            out << std::setw(4) << m_parameter_schema;
+            out.close();
+            boost::filesystem::rename(tmp_path, cached_path);
+        }
+    }
+
+    void misa_runtime_impl::resolve_parameters() {
+        const auto properties = m_parameter_schema.find("properties");
+        if (properties == m_parameter_schema.end())
+            return;
+
+        std::vector<std::string> missing;
+        for (const std::string key : { "algorithm", "samples", "runtime" }) {
+            const auto schema = properties->find(key);
+            if (schema == properties->end())
+                continue;
+            const auto parameters = m_parameters.find(key);
+            index_parameters(schema.value(), parameters != m_parameters.end() ? &parameters.value() : nullptr, "/" + key,
+                             false, m_parameter_index, missing);
+        }
+
+        if (!missing.empty()) {
+            std::string message = "The following required parameters do not exist:";
+            for (const std::string &key : missing) {
+                message += " " + key;
+            }
+            throw std::runtime_error(message);
+        }
+    }
+
+    const nlohmann::json *misa_runtime_impl::find_parameter_value(const std::vector<std::string> &t_path) const {
+        if (!m_parameter_index.empty()) {
+            const auto it = m_parameter_index.find(get_parameter_key(t_path));
+            if (it != m_parameter_index.end())
+                return it->second;
+        }
+
+        // Parameters that are not indexed
+        const nlohmann::json *result = &m_parameters;
+        for (const auto &key : t_path) {
+            const auto it = result->find(key);
+            if (it == result->end())
+                return nullptr;
+            result = &it.value();
+        }
+        return result;
+    }
+
+    void misa_runtime_impl::reset_scheduler() {
+        m_nodes_ready = {};
+        m_nodes_ready_sequence = 0;
+        m_node_ranks.clear();
+        m_nodes_rejected.clear();
+        m_unfinished_children.clear();
+        m_incomplete_builds.clear();
+        m_nodes_pending = 0;
+        m_incomplete_subtrees = 0;
+        m_nodes_waiting_for_dependencies = 0;
+        m_known_nodes_count = 0;
+        m_finished_nodes_count = 0;
+        m_tree_complete = false;
+    }
+
+    std::string misa_runtime_impl::get_parameter_schema_key() {
+        misa_sha256 hash;
+        hash.update(nlohmann::json(m_module_info).dump());
+
+        // Only the structure of the parameters is relevant. Runtime parameters are not part of it.
+        std::vector<std::pair<std::string, const nlohmann::json*>> stack { { "", &m_parameters } };
+        while (!stack.empty()) {
+            const auto [path, current] = stack.back();
+            stack.pop_back();
+            hash.update(path);
+            if (current->is_object()) {
+                for (auto it = current->begin(); it != current->end(); ++it) {
+                    if (path.empty() && it.key() == "runtime")
+                        continue;
+                    stack.emplace_back(path + "/" + it.key(), &it.value());
+                }
+            }
+        }
+
+        // The samples are imported from the filesystem. Their data does not change the schema.
+        for (const auto &kv : *get_filesystem().imported) {
+            hash.update(kv.first);
+        }
+        return hash.to_string();
+    }
+
+    void misa_runtime_impl::progress(const std::string &t_text, misaxx::utils::log_level t_level) {
+        misaxx::utils::log_message message(t_level);
         if (m_tree_complete) {
-            std::cout << "<" << static_cast<int>(m_finished_nodes_count * 1.0 / m_known_nodes_count * 100) << "%" << ">";
+            message << "<" << static_cast<int>(m_finished_nodes_count * 1.0 / m_known_nodes_count * 100) << "%" << ">";
         } else {
-            std::cout << "<#>";
+            message << "<#>";
         }
-        std::cout << " " << "<" << m_finished_nodes_count << " / " << m_known_nodes_count << ">";
-
-        std::cout << "\t" << t_text;
-        std::cout << "\n";
+        message << " " << "<" << m_finished_nodes_count << " / " << m_known_nodes_count << ">";
+        message << "\t" << t_text;
     }
 
-    void misa_runtime_impl::progress(const misa_work_node &t_node, const std::string &t_text) {
+    void misa_runtime_impl::progress(const misa_work_node &t_node, const std::string &t_text, misaxx::utils::log_level t_level) {
+        misaxx::utils::log_message message(t_level);
         if (m_tree_complete) {
-            std::cout << "<" << static_cast<int>(m_finished_nodes_count * 1.0 / m_known_nodes_count * 100) << "%" << ">";
+            message << "<" << static_cast<int>(m_finished_nodes_count * 1.0 / m_known_nodes_count * 100) << "%" << ">";
         } else {
-            std::cout << "<#>";
+            message << "<#>";
         }
-        std::cout << " " << "<" << m_finished_nodes_count << " / " << m_known_nodes_count << ">";
-        std::cout << "\t" << t_text << " " << *t_node.get_global_path() << " @ " << static_cast<const void*>(&t_node);
-        std::cout << "\n";
+        message << " " << "<" << m_finished_nodes_count << " / " << m_known_nodes_count << ">";
+        message << "\t" << t_text << " " << *t_node.get_global_path() << " @ " << static_cast<const void*>(&t_node);
     }
 
-    void misa_runtime_impl::run_single_threaded() {
-        while (!m_nodes_todo.empty()) {
+    bool misa_runtime_impl::is_progress_due() {
+        if (misaxx::utils::is_logging(misaxx::utils::log_level::debug) || m_finished_nodes_count == m_known_nodes_count)
+            return true;
+        const auto now = std::chrono::steady_clock::now();
+        if (now - m_last_progress_time < progress_interval)
+            return false;
+        m_last_progress_time = now;
+        return true;
+    }
+
+    bool misa_runtime_impl::enqueue(misa_work_node *t_node) {
+        ++m_known_nodes_count;
+        ++m_nodes_pending;
 
-            size_t missing_dependency = 0;
-            size_t rejected = 0;
-            bool tree_complete = true;
+        if (dynamic_cast<misa_task *>(t_node->get_or_create_instance().get()) == nullptr) {
+            ++m_incomplete_subtrees;
+        }
 
-            for (size_t i = 0; i < m_nodes_todo.size(); ++i) {
-                auto *nd = m_nodes_todo[i];
+        size_t unfinished_dependencies = 0;
+        for (const auto &dep : t_node->get_dependencies()) {
+            if (dep->get_worker_status() != misa_worker_status::done) {
+                dep->add_dependent(t_node);
+                invalidate_rank(dep.get());
+                ++unfinished_dependencies;
+            }
+        }
+        t_node->set_unfinished_dependencies(unfinished_dependencies);
 
-                if (nd->get_subtree_status() != misa_work_subtree_status::complete)
-                    tree_complete = false;
+        if (unfinished_dependencies > 0) {
+            ++m_nodes_waiting_for_dependencies;
+            return false;
+        }
+        return true;
+    }
 
-                // First check if we even can do work
-                if (!nd->dependencies_satisfied()) {
-                    ++missing_dependency;
-                    continue;
+    void misa_runtime_impl::process_worked(misa_work_node *t_node) {
+        const misa_worker_status status = t_node->get_worker_status();
+        if (status == misa_worker_status::queued_repeat) {
+            // If the work was rejected, don't do any additional steps afterwards
+            m_nodes_rejected.push_back(t_node);
+            return;
+        }
+
+        if (const auto task = dynamic_cast<misa_task *>(t_node->get_instance().get())) {
+            m_cache_inputs_declared |= !task->get_cache_usage().inputs.empty();
+            // Tasks never build a subtree
+            finish(t_node);
+            return;
+        }
+
+        // The dispatcher created its subtree. Look for new nodes to visit.
+        const auto dispatcher = std::dynamic_pointer_cast<misa_dispatcher>(t_node->get_instance());
+        if (static_cast<bool>(dispatcher) && !dispatcher->is_build_complete()) {
+            m_incomplete_builds.insert(t_node);
+        } else {
+            complete_subtree();
+        }
+        size_t unfinished_children = enqueue_children(t_node, 0);
+        if (unfinished_children == 0 && m_incomplete_builds.count(t_node) > 0) {
+            unfinished_children = build_incremental(t_node);
+        }
+        if (unfinished_children > 0) {
+            m_unfinished_children[t_node] = unfinished_children;
+        } else {
+            finish(t_node);
+        }
+    }
+
+    size_t misa_runtime_impl::enqueue_children(misa_work_node *t_node, size_t t_first) {
+        size_t unfinished_children = 0;
+        std::vector<misa_work_node *> ready_children;
+        const auto &children = t_node->get_children();
+        for (size_t i = t_first; i < children.size(); ++i) {
+            if (children[i]->get_worker_status() == misa_worker_status::undone) {
+                if (enqueue(children[i].get())) {
+                    ready_children.push_back(children[i].get());
+                }
+                ++unfinished_children;
+            }
+        }
+
+        // Ranks depend on the dependents, so the whole subtree must be known before nodes become ready
+        for (misa_work_node *child : ready_children) {
+            push_ready(child);
+        }
+        return unfinished_children;
+    }
+
+    size_t misa_runtime_impl::build_incremental(misa_work_node *t_node) {
+        const auto dispatcher = std::dynamic_pointer_cast<misa_dispatcher>(t_node->get_instance());
+        const size_t known_children = t_node->get_children().size();
+        dispatcher->execute_incremental_work();
+        const size_t new_children = enqueue_children(t_node, known_children);
+
+        // A dispatcher without any running children cannot continue its build later
+        if (dispatcher->is_build_complete() || (new_children == 0 && m_unfinished_children.count(t_node) == 0)) {
+            m_incomplete_builds.erase(t_node);
+            complete_subtree();
+        }
+        return new_children;
+    }
+
+    void misa_runtime_impl::complete_subtree() {
+        --m_incomplete_subtrees;
+        m_tree_complete |= m_incomplete_subtrees == 0;
+    }
+
+    void misa_runtime_impl::finish(misa_work_node *t_node) {
+        ++m_finished_nodes_count;
+        --m_nodes_pending;
+        if (is_progress_due()) {
+            progress(*t_node, "Work finished on");
+        }
+
+        // Wake up the nodes that are waiting for this node
+        for (misa_work_node *dependent : t_node->get_dependents()) {
+            if (dependent->notify_dependency_finished()) {
+                --m_nodes_waiting_for_dependencies;
+                // Fused dependents are already worked by the job of this node
+                if (m_fused_nodes.count(dependent) == 0) {
+                    push_ready(dependent, t_node);
                 }
+            }
+        }
 
-                auto subtree_before = nd->get_subtree_status();
-                if (nd->get_worker_status() == misa_worker_status::undone ||
-                    nd->get_worker_status() == misa_worker_status::queued_repeat) {
-                    if (nd->get_worker_status() == misa_worker_status::queued_repeat) {
-                        progress(*nd, "Retrying single-threaded work on");
-                    } else {
-                        progress(*nd, "Starting single-threaded work on");
-                    }
-                    if (m_write_full_runtime_log) {
-                        m_runtime_log.start(0, misaxx::utils::to_string(*nd->get_global_path()));
+        // Finished nodes might have been the reason why other nodes rejected their work
+        retry_rejected();
+
+        // A dispatcher is finished if all of its children are finished
+        auto parent = t_node->get_parent().lock();
+        if (parent == m_root && is_streaming_samples()) {
+            m_finished_samples.push_back(t_node);
+        }
+        if (static_cast<bool>(parent)) {
+            auto it = m_unfinished_children.find(parent.get());
+            if (it != m_unfinished_children.end()) {
+                size_t unfinished_children = --it->second;
+                if (m_incomplete_builds.count(parent.get()) > 0) {
+                    if (unfinished_children == 0) {
+                        m_unfinished_children.erase(it);
                     }
-                    nd->prepare_work();
-                    nd->work();
-                    if (m_write_full_runtime_log) {
-                        m_runtime_log.stop(0);
+                    unfinished_children += build_incremental(parent.get());
+                    if (unfinished_children > 0) {
+                        m_unfinished_children[parent.get()] = unfinished_children;
                     }
                 }
-                if (nd->get_worker_status() == misa_worker_status::queued_repeat) {
-                    // If the work was rejected, don't do any additional steps afterwards
-                    ++rejected;
-                    continue;
+                else if (unfinished_children == 0) {
+                    m_unfinished_children.erase(it);
                 }
-                if (subtree_before == misa_work_subtree_status::incomplete) {
-                    // Look for new nodes to visit
-                    for (auto &child : nd->get_children()) {
-                        if (child->get_worker_status() == misa_worker_status::undone &&
-                            m_nodes_todo_lookup.find(child.get()) == m_nodes_todo_lookup.end()) {
-                            m_nodes_todo_lookup.insert(child.get());
-                            m_nodes_todo.push_back(child.get());
-                            ++m_known_nodes_count;
-                        }
-                    }
+                if (unfinished_children == 0) {
+                    finish(parent.get());
+                }
+            }
+        }
+    }
+
+    void misa_runtime_impl::retry_rejected() {
+        for (misa_work_node *nd : m_nodes_rejected) {
+            push_ready(nd);
+        }
+        m_nodes_rejected.clear();
+    }
+
+    double misa_runtime_impl::get_cost(misa_work_node *t_node) const {
+        const auto instance = t_node->get_instance();
+        if (const auto task = std::dynamic_pointer_cast<misa_task>(instance)) {
+            const double hint = task->get_cost_estimate();
+            if (hint > 0)
+                return hint;
+            if (m_cost_history.empty())
+                return 0;
+            return m_cost_history.get_cost(misaxx::utils::to_string(*t_node->get_global_path()));
+        }
+        if (m_cost_history.empty())
+            return 0;
+        return m_cost_history.get_subtree_cost(misaxx::utils::to_string(*t_node->get_global_path()));
+    }
+
+    double misa_runtime_impl::get_rank(misa_work_node *t_node) {
+        auto it = m_node_ranks.find(t_node);
+        if (it != m_node_ranks.end())
+            return it->second;
+
+        // Depth-first search with an explicit stack, as chains can be very long.
+        // Each entry holds the index of the next dependent to visit.
+        std::vector<std::pair<misa_work_node *, size_t>> stack { { t_node, 0 } };
+        while (!stack.empty()) {
+            misa_work_node *nd = stack.back().first;
+            const auto &dependents = nd->get_dependents();
+            misa_work_node *unranked = nullptr;
+            while (stack.back().second < dependents.size()) {
+                misa_work_node *dependent = dependents[stack.back().second++];
+                if (m_node_ranks.find(dependent) == m_node_ranks.end()) {
+                    unranked = dependent;
+                    break;
                 }
-                if (nd->get_worker_status() == misa_worker_status::done &&
-                    nd->get_subtree_status() == misa_work_subtree_status::complete) {
-                    // Use quick-delete to remove the completed node
-                    std::swap(m_nodes_todo[i], m_nodes_todo[m_nodes_todo.size() - 1]);
-                    m_nodes_todo.resize(m_nodes_todo.size() - 1);
-                    --i;
-                    ++m_finished_nodes_count;
-                    progress(*nd, "Work finished on");
+            }
+            if (unranked != nullptr) {
+                stack.emplace_back(unranked, 0);
+                continue;
+            }
+
+            double rank = 0;
+            for (misa_work_node *dependent : dependents) {
+                rank = std::max(rank, m_node_ranks.at(dependent));
+            }
+            m_node_ranks[nd] = rank + get_cost(nd);
+            stack.pop_back();
+        }
+        return m_node_ranks.at(t_node);
+    }
+
+    void misa_runtime_impl::invalidate_rank(misa_work_node *t_node) {
+        // Ranked nodes only have ranked dependents, so the search stops at nodes without a rank
+        std::vector<misa_work_node *> stack { t_node };
+        while (!stack.empty()) {
+            misa_work_node *nd = stack.back();
+            stack.pop_back();
+            if (m_node_ranks.erase(nd) == 0)
+                continue;
+            for (const auto &dependency : nd->get_dependencies()) {
+                stack.push_back(dependency.get());
+            }
+        }
+    }
+
+    void misa_runtime_impl::announce_blocked_workers() {
+        if (!misaxx::utils::is_logging(misaxx::utils::log_level::debug))
+            return;
+        if (m_nodes_waiting_for_dependencies > 0 &&
+            m_nodes_waiting_for_dependencies != m_last_waiting_announcement) {
+            progress("Info: " + std::to_string(m_nodes_waiting_for_dependencies) +
+                     " workers are waiting for dependencies", misaxx::utils::log_level::debug);
+        }
+        m_last_waiting_announcement = m_nodes_waiting_for_dependencies;
+        if (!m_nodes_rejected.empty() && m_nodes_rejected.size() != m_last_rejecting_announcement) {
+            progress("Info: " + std::to_string(m_nodes_rejected.size()) + " workers are rejecting to work", misaxx::utils::log_level::debug);
+        }
+        m_last_rejecting_announcement = m_nodes_rejected.size();
+    }
+
+    void misa_runtime_impl::run_single_threaded() {
+        while (m_nodes_pending > 0) {
+
+            if (m_nodes_ready.empty()) {
+                if (m_nodes_rejected.empty()) {
+                    throw std::logic_error(std::to_string(m_nodes_waiting_for_dependencies) +
+                                           " workers are waiting for dependencies that will never be satisfied!");
                 }
+                retry_rejected();
             }
 
-            m_tree_complete |= tree_complete;
+            auto *nd = pop_ready();
 
-            if (missing_dependency > 0 && missing_dependency != m_last_waiting_announcement) {
-                progress("Info: " + std::to_string(missing_dependency) + " workers are waiting for dependencies");
-                m_last_waiting_announcement = missing_dependency;
+            if (nd->get_worker_status() == misa_worker_status::queued_repeat) {
+                progress(*nd, "Retrying single-threaded work on", misaxx::utils::log_level::debug);
+            } else {
+                progress(*nd, "Starting single-threaded work on", misaxx::utils::log_level::debug);
+            }
+            if (m_write_full_runtime_log) {
+                m_runtime_log.start(0, misaxx::utils::to_string(*nd->get_global_path()));
             }
-            if (rejected > 0 && rejected != m_last_rejecting_announcement) {
-                progress("Info: " + std::to_string(rejected) + " workers are rejecting to work");
-                m_last_rejecting_announcement = rejected;
+            if (nd->get_worker_status() != misa_worker_status::ready) {
+                nd->prepare_work();
             }
+            {
+                misaxx::utils::trace_span span("worker", get_trace_name(*nd));
+                nd->work();
+            }
+            if (m_write_full_runtime_log) {
+                m_runtime_log.stop(0);
+            }
+
+            process_worked(nd);
+            release_finished_samples();
+            announce_blocked_workers();
         }
     }
 
     void misa_runtime_impl::run_parallel() {
-        omp_set_num_threads(this->m_num_threads);
+        if (!m_pool) {
+            create_pool();
+        }
+        progress("Runtime dispatcher started with " + std::to_string(m_pool->get_num_threads()) + " worker threads");
+        if (m_pool->is_numa_aware()) {
+            progress("Info: Worker threads are pinned to " + std::to_string(misaxx::utils::get_numa_topology().size()) + " NUMA nodes");
+        }
+
+        m_dispatcher_finished = false;
+        m_dispatcher_exception = nullptr;
+        schedule_dispatcher();
+
+        std::unique_lock<std::mutex> lock(m_nodes_worked_mutex);
+        m_dispatcher_finished_condition.wait(lock, [this]() { return m_dispatcher_finished; });
+        if (m_dispatcher_exception) {
+            std::rethrow_exception(m_dispatcher_exception);
+        }
+        if (m_memory_waits_count > 0) {
+            progress("Info: " + std::to_string(m_memory_waits_count) + " workers had to wait for memory");
+        }
+        if (m_slot_waits_count > 0) {
+            progress("Info: " + std::to_string(m_slot_waits_count) + " workers had to wait for a resource slot");
+        }
+        if (m_batches_count > 0) {
+            progress("Info: " + std::to_string(m_batched_nodes_count) + " tasks were run in " + std::to_string(m_batches_count) + " batches");
+        }
+        if (m_fused_nodes_count > 0) {
+            progress("Info: " + std::to_string(m_fused_nodes_count) + " tasks were fused with their dependency");
+        }
+        progress("Runtime dispatcher ended");
+    }
+
+    void misa_runtime_impl::create_pool() {
+        // Exceptions that escape from a job stop the dispatcher instead of the worker thread
+        m_pool = std::make_unique<misaxx::utils::work_stealing_pool>(m_num_threads,
+                misaxx::utils::get_thread_affinity(m_thread_affinity, m_num_threads),
+                [this](std::exception_ptr t_exception) {
+                    finish_dispatcher(std::move(t_exception));
+                });
+    }
 
-        #pragma omp parallel
+    void misa_runtime_impl::schedule_dispatcher() {
+        if (!m_dispatcher_scheduled.exchange(true)) {
+            m_pool->submit([this]() {
+                dispatch();
+            });
+        }
+    }
+
+    void misa_runtime_impl::finish_dispatcher(std::exception_ptr t_exception) {
         {
-            #pragma omp master
-            {
-                progress("Runtime dispatcher started in thread " + std::to_string(omp_get_thread_num()));
-                const int master_thread_id = omp_get_thread_num();
-                while (!m_nodes_todo.empty()) {
+            std::lock_guard<std::mutex> lock(m_nodes_worked_mutex);
+            if (m_dispatcher_finished)
+                return;
+            m_dispatcher_exception = std::move(t_exception);
+            m_dispatcher_finished = true;
+        }
+        m_dispatcher_finished_condition.notify_all();
+    }
 
-                    size_t missing_dependency = 0;
-                    size_t rejected = 0;
-                    bool tree_complete = true;
+    void misa_runtime_impl::dispatch() {
+        misaxx::utils::trace_span span("runtime", "dispatch");
+        try {
+            while (true) {
+
+                // Collect the nodes that were finished by other threads
+                std::vector<worked_node> worked;
+                {
+                    std::lock_guard<std::mutex> lock(m_nodes_worked_mutex);
+                    if (m_dispatcher_finished) {
+                        m_dispatcher_scheduled = false;
+                        return;
+                    }
+                    std::swap(worked, m_nodes_worked);
+                }
+                for (const worked_node &w : worked) {
+                    --m_nodes_running;
+                    if (m_batch_duration > 0 && w.node->get_worker_status() != misa_worker_status::queued_repeat &&
+                        dynamic_cast<misa_task *>(w.node->get_instance().get()) != nullptr) {
+                        auto &measured = m_measured_costs[misaxx::utils::to_string(*w.node->get_algorithm_path())];
+                        measured.first += w.runtime;
+                        ++measured.second;
+                    }
+                    if (m_pool->is_numa_aware()) {
+                        m_node_threads[w.node] = w.thread;
+                    }
+                    m_producer_threads.erase(w.node);
+                    if (m_fused_nodes.erase(w.node) > 0) {
+                        ++m_fused_nodes_count;
+                    }
+                    if (w.node->get_worker_status() == misa_worker_status::queued_repeat) {
+                        unfuse_successors(w.node);
+                    } else {
+                        m_fused_successors.erase(w.node);
+                    }
+                    finish_measurement(w.node);
+                    release_memory(w.node);
+                    release_slot(w.node);
+                    m_worked_thread = w.thread;
+                    process_worked(w.node);
+                    m_worked_thread = -1;
+                }
+                release_finished_samples();
 
-                    for (size_t i = 0; i < m_nodes_todo.size(); ++i) {
-                        auto *nd = m_nodes_todo[i];
+                // Nodes that already wait for memory have priority
+                start_waiting_for_memory();
 
-                        if (nd->get_subtree_status() != misa_work_subtree_status::complete)
-                            tree_complete = false;
+                // Start all ready nodes
+                while (!m_nodes_ready.empty()) {
+                    auto *nd = pop_ready();
+                    if (wait_for_measurement(nd))
+                        continue;
 
-                        // First check if we even can do work
-                        if (!nd->dependencies_satisfied()) {
-                            ++missing_dependency;
-                            continue;
-                        }
+                    const bool parallelizeable = nd->is_parallelizeable();
+                    if (nd->get_worker_status() == misa_worker_status::queued_repeat) {
+                        progress(*nd, parallelizeable ? "Retrying parallelized work on" : "Retrying single-threaded work on", misaxx::utils::log_level::debug);
+                    } else {
+                        progress(*nd, parallelizeable ? "Starting parallelized work on" : "Starting single-threaded work on", misaxx::utils::log_level::debug);
+                    }
+                    // Nodes that were prepared as fusion candidates are already prepared
+                    if (nd->get_worker_status() != misa_worker_status::ready) {
+                        nd->prepare_work();
+                    }
 
-                        auto subtree_before = nd->get_subtree_status();
-                        if (nd->get_worker_status() == misa_worker_status::undone ||
-                            nd->get_worker_status() == misa_worker_status ::nothread ||
-                            nd->get_worker_status() == misa_worker_status::queued_repeat) {
-
-                            if (!nd->is_parallelizeable()) {
-                                if (nd->get_worker_status() == misa_worker_status::queued_repeat) {
-                                    progress(*nd, "Retrying single-threaded work on");
-                                } else {
-                                    progress(*nd, "Starting single-threaded work on");
-                                }
-                                if (m_write_full_runtime_log) {
-                                    m_runtime_log.start(0, misaxx::utils::to_string(*nd->get_global_path()));
-                                }
-                                if(nd->get_worker_status() != misa_worker_status::ready &&
-                                    nd->get_worker_status() != misa_worker_status::nothread) {
-                                    nd->prepare_work();
-                                }
-
-                                nd->work();
-                                if (m_write_full_runtime_log) {
-                                    m_runtime_log.stop(0);
-                                }
-                            } else {
-                                switch(nd->get_worker_status()) {
-                                    case misa_worker_status ::nothread:
-                                        break;
-                                    case misa_worker_status::queued_repeat:
-                                        progress(*nd, "Retrying parallelized work on");
-                                        break;
-                                    case misa_worker_status::undone:
-                                    case misa_worker_status::ready:
-                                    case misa_worker_status::working:
-                                    case misa_worker_status::done:
-                                    case misa_worker_status::waiting:
-                                    default:
-                                        progress(*nd, "Starting parallelized work on");
-                                }
-
-                                // Wake the worker up
-                                if(nd->get_worker_status() == misa_worker_status::nothread) {
-                                    nd->set_nothread(false);
-                                }
-
-                                // Prepare work if not ready or in nothread mode
-                                if(nd->get_worker_status() != misa_worker_status::ready) {
-                                    nd->prepare_work();
-                                }
-
-                                #pragma omp task firstprivate(nd) firstprivate(master_thread_id)
-                                {
-                                    if(omp_get_thread_num() == master_thread_id) {
-                                        nd->set_nothread(true);
-                                    }
-                                    else {
-                                        if (m_write_full_runtime_log) {
-                                            m_runtime_log.start(omp_get_thread_num(),
-                                                                misaxx::utils::to_string(*nd->get_global_path()));
-                                        }
-                                        nd->work();
-                                        if (m_write_full_runtime_log) {
-                                            m_runtime_log.stop(omp_get_thread_num());
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                        if (nd->get_worker_status() == misa_worker_status::queued_repeat) {
-                            // If the work was rejected, don't do any additional steps afterwards
-                            ++rejected;
-                            continue;
-                        }
-                        if (subtree_before == misa_work_subtree_status::incomplete) {
-                            // Look for new nodes to visit
-                            for (auto &child : nd->get_children()) {
-                                if (child->get_worker_status() == misa_worker_status::undone &&
-                                    m_nodes_todo_lookup.find(child.get()) == m_nodes_todo_lookup.end()) {
-                                    m_nodes_todo_lookup.insert(child.get());
-                                    m_nodes_todo.push_back(child.get());
-                                    ++m_known_nodes_count;
-                                }
-                            }
-                        }
-                        if (nd->get_worker_status() == misa_worker_status::done &&
-                            nd->get_subtree_status() == misa_work_subtree_status::complete) {
-                            // Use quick-delete to remove the completed node
-                            std::swap(m_nodes_todo[i], m_nodes_todo[m_nodes_todo.size() - 1]);
-                            m_nodes_todo.resize(m_nodes_todo.size() - 1);
-                            --i;
-                            ++m_finished_nodes_count;
-                            progress(*nd, "Work finished on");
+                    // Parallelized tasks wait for a slot of their resource class before they reserve memory
+                    if (parallelizeable && !try_acquire_slot(nd)) {
+                        ++m_slot_waits_count;
+                        m_nodes_waiting_for_slot[static_cast<size_t>(get_resource_class(nd))].push_back(nd);
+                        progress(*nd, "Info: Waiting for a resource slot on", misaxx::utils::log_level::debug);
+                        continue;
+                    }
+
+                    // Tasks with a memory estimate start in order to prevent starvation of large tasks
+                    const size_t estimate = get_memory_estimate(nd);
+                    if (estimate > 0 && (!m_nodes_waiting_for_memory.empty() || !try_reserve_memory(nd, estimate))) {
+                        ++m_memory_waits_count;
+                        m_nodes_waiting_for_memory.push_back(nd);
+                        progress(*nd, "Info: Waiting for " + std::to_string(estimate / 1024 / 1024) + " MB of memory (" +
+                                      std::to_string(m_memory_in_use / 1024 / 1024) + " of " +
+                                      std::to_string(m_memory_budget / 1024 / 1024) + " MB in use) on", misaxx::utils::log_level::debug);
+                        continue;
+                    }
+                    if (estimate == 0 && parallelizeable) {
+                        auto batch = collect_batch(nd);
+                        if (batch.size() > 1) {
+                            ++m_batches_count;
+                            m_batched_nodes_count += batch.size();
+                            progress(*nd, "Info: Batching " + std::to_string(batch.size() - 1) + " sibling tasks with", misaxx::utils::log_level::debug);
                         }
+                        start_batch(std::move(batch));
+                        continue;
                     }
+                    start_work(nd);
+                }
 
-                    m_tree_complete |= tree_complete;
+                announce_blocked_workers();
 
-                    if (missing_dependency > 0 && missing_dependency != m_last_waiting_announcement) {
-                        progress("Info: " + std::to_string(missing_dependency) +
-                                 " workers are waiting for dependencies");
-                        m_last_waiting_announcement = missing_dependency;
+                if (m_nodes_pending == 0) {
+                    m_dispatcher_scheduled = false;
+                    finish_dispatcher(nullptr);
+                    return;
+                }
+                if (m_nodes_running == 0) {
+                    if (m_nodes_rejected.empty()) {
+                        throw std::logic_error(std::to_string(m_nodes_waiting_for_dependencies) +
+                                               " workers are waiting for dependencies that will never be satisfied!");
                     }
-                    if (rejected > 0 && rejected != m_last_rejecting_announcement) {
-                        progress("Info: " + std::to_string(rejected) + " workers are rejecting to work");
-                        m_last_rejecting_announcement = rejected;
+                    retry_rejected();
+                    continue;
+                }
+
+                // Wait until the next node is finished by another thread
+                {
+                    std::lock_guard<std::mutex> lock(m_nodes_worked_mutex);
+                    if (m_nodes_worked.empty()) {
+                        m_dispatcher_scheduled = false;
+                        return;
                     }
                 }
-                progress("Runtime dispatcher thread ended");
             }
         }
+        catch (...) {
+            m_dispatcher_scheduled = false;
+            finish_dispatcher(std::current_exception());
+        }
     }
 
-    void misa_runtime_impl::postprocess_caches() {
-        if (!m_is_simulating) {
-            std::cout << "[Caches] Post-processing caches ..." << "\n";
-            if (!m_write_full_runtime_log) {
-                m_runtime_log.start(0, "Postprocessing");
+    std::string misa_runtime_impl::get_trace_name(const misa_work_node &t_node) {
+        if(!misaxx::utils::is_tracing())
+            return std::string();
+        return misaxx::utils::to_string(*t_node.get_global_path());
+    }
+
+    void misa_runtime_impl::start_work(misa_work_node *t_node) {
+        if (!t_node->is_parallelizeable()) {
+            const int thread = misaxx::utils::work_stealing_pool::get_current_thread_index();
+            if (m_write_full_runtime_log) {
+                m_runtime_log.start(thread, misaxx::utils::to_string(*t_node->get_global_path()));
             }
-            for (const std::shared_ptr<misa_cache> &ptr : m_registered_caches) {
-                if (m_write_full_runtime_log) {
-                    m_runtime_log.start(0, "Postprocessing " + ptr->get_location().string() + " (" +
-                                           ptr->get_unique_location().string() + ")");
-                }
-                std::cout << "[Caches] Post-processing cache " << ptr->get_location() << " (" << ptr->get_unique_location()
-                          << ")" << "\n";
-                ptr->postprocess();
-                if (ptr->has_data()) {
-                    std::cout << "[Caches] Info: " << ptr->get_location() << " (" << ptr->get_unique_location()
-                              << ")" << " reports that it still contains data" << "\n";
-                }
-                if (m_write_full_runtime_log) {
-                    m_runtime_log.stop(0);
-                }
+            ++m_threads_working;
+            try {
+                misaxx::utils::trace_span span("worker", get_trace_name(*t_node));
+                t_node->work();
             }
-            if (!m_write_full_runtime_log) {
-                m_runtime_log.stop(0);
+            catch (...) {
+                --m_threads_working;
+                throw;
             }
+            --m_threads_working;
+            if (m_write_full_runtime_log) {
+                m_runtime_log.stop(thread);
+            }
+            release_memory(t_node);
+            process_worked(t_node);
+            return;
         }
+
+        start_batch({ t_node });
     }
 
-    void misa_runtime_impl::postprocess_cache_attachments() {
-        if (!m_write_attachments) {
-            std::cout << "[Attachments] Post-processing attachments ... Skipped" << "\n";
+    int misa_runtime_impl::get_thread_budget() const {
+        if (!m_pool)
+            return 1;
+        // The calling task is one of the working threads
+        const int idle_threads = m_pool->get_num_threads() - std::max(1, m_threads_working.load());
+        return 1 + std::max(0, idle_threads);
+    }
+
+    void misa_runtime_impl::parallel_for(int t_num_jobs, const std::function<void(int)> &t_job) {
+        const int num_threads = std::min(t_num_jobs, get_thread_budget());
+        if (num_threads <= 1) {
+            for (int i = 0; i < t_num_jobs; ++i) {
+                t_job(i);
+            }
             return;
         }
 
-        std::cout << "[Attachments] Post-processing attachments ..." << "\n";
-
-        if (!m_write_full_runtime_log) {
-            m_runtime_log.start(0, "Attachments");
+        // Jobs that are submitted into the pool can start after this function returned.
+        // They only access t_job if they claimed a job index before all indices were claimed by the calling thread.
+        struct parallel_for_state {
+            std::atomic<int> next_job { 0 };
+            std::atomic<int> active_threads { 0 };
+            std::mutex mutex;
+            std::condition_variable finished_condition;
+            std::exception_ptr exception;
+        };
+        auto state = std::make_shared<parallel_for_state>();
+        const auto run_jobs = [state, t_num_jobs, &t_job]() {
+            ++state->active_threads;
+            int job;
+            while ((job = state->next_job++) < t_num_jobs) {
+                try {
+                    t_job(job);
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    if (!state->exception)
+                        state->exception = std::current_exception();
+                    state->next_job = t_num_jobs;
+                }
+            }
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                --state->active_threads;
+            }
+            state->finished_condition.notify_all();
+        };
+
+        // Borrowed threads count as working, so nested loops and other tasks see a smaller thread budget
+        for (int i = 1; i < num_threads; ++i) {
+            m_pool->submit([this, run_jobs]() {
+                ++m_threads_working;
+                run_jobs();
+                --m_threads_working;
+            });
         }
+        run_jobs();
 
-        // Attachment JSON schemata
-        nlohmann::json attachment_schemata;
-
-        for (const std::shared_ptr<misa_cache> &ptr : m_registered_caches) {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->finished_condition.wait(lock, [&state]() { return state->active_threads == 0; });
+        if (state->exception) {
+            std::rethrow_exception(state->exception);
+        }
+    }
 
-            if (ptr->get_unique_location().empty())
-                continue;
+    void misa_runtime_impl::write_output_json(const boost::filesystem::path &t_path, nlohmann::json t_json) {
+        std::unique_ptr<misaxx::utils::scoped_lock_file> lock;
+        if (is_sharded()) {
+            boost::filesystem::create_directories(t_path.parent_path());
+            lock = std::make_unique<misaxx::utils::scoped_lock_file>(t_path.string() + ".lock", get_shard_id());
+            if (boost::filesystem::exists(t_path)) {
+                nlohmann::json merged;
+                std::ifstream in;
+                in.open(t_path.string());
+                in >> merged;
+                in.close();
+                merged.merge_patch(t_json);
+                t_json = std::move(merged);
+            }
+        }
+        std::ofstream out;
+        out.open(t_path.string());
+        out << std::setw(4) << t_json;
+        out.close();
+    }
 
-            if (!m_is_simulating) {
+    void misa_runtime_impl::run_postprocessing_jobs(size_t t_num_jobs, const std::function<void(size_t, int)> &t_job) {
+        if (m_num_threads <= 1 || m_is_simulating || t_num_jobs <= 1) {
+            for (size_t i = 0; i < t_num_jobs; ++i) {
+                t_job(i, 0);
+            }
+            return;
+        }
+        if (!m_pool) {
+            create_pool();
+        }
 
-                if (m_write_full_runtime_log) {
-                    m_runtime_log.start(0, "Attachments: " + ptr->get_location().string() + " (" +
-                                           ptr->get_unique_location().string() + ")");
+        // The calling thread only waits, so the runtime log entries of each worker thread stay consistent
+        std::atomic<size_t> next_job { 0 };
+        int active_threads = static_cast<int>(std::min(static_cast<size_t>(m_pool->get_num_threads()), t_num_jobs));
+        std::mutex mutex;
+        std::condition_variable finished_condition;
+        std::exception_ptr exception;
+        for (int i = 0, n = active_threads; i < n; ++i) {
+            m_pool->submit([&]() {
+                const int thread = misaxx::utils::work_stealing_pool::get_current_thread_index();
+                size_t index;
+                while ((index = next_job++) < t_num_jobs) {
+                    try {
+                        t_job(index, thread);
+                    }
+                    catch (...) {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        if (!exception)
+                            exception = std::current_exception();
+                        next_job = t_num_jobs;
+                    }
                 }
-
-                readonly_access<typename misa_cached_data_base::attachment_type> access(ptr->attachments); // Open the cache
-
-                if (m_lazy_write_attachments && access.get().empty()) {
-                    continue;
+                std::lock_guard<std::mutex> lock(mutex);
+                if (--active_threads == 0) {
+                    finished_condition.notify_all();
                 }
+            });
+        }
 
-                std::cout << "[Attachments] Post-processing attachment " << ptr->get_location() << " ("
-                          << ptr->get_unique_location() << ")" << "\n";
-
-                boost::filesystem::path filesystem_unique_link_path = ptr->get_internal_unique_location();
-                boost::filesystem::path filesystem_generic_link_path = ptr->get_internal_location();
-
-                // Replace extension with JSON
-                const boost::filesystem::path filesystem_export_base_path = get_filesystem().exported->external_path();
-                boost::filesystem::path cache_attachment_path =
-                        (filesystem_export_base_path / "attachments" / filesystem_unique_link_path).string() + ".json";
-                boost::filesystem::create_directories(cache_attachment_path.parent_path());
+        std::unique_lock<std::mutex> lock(mutex);
+        finished_condition.wait(lock, [&active_threads]() { return active_threads == 0; });
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
 
-                nlohmann::json exported_json = nlohmann::json(nlohmann::json::object());
+    void misa_runtime_impl::for_each_registered_cache(const std::function<void(const std::shared_ptr<misa_cache> &, int)> &t_function) {
+        const std::vector<std::shared_ptr<misa_cache>> caches(m_registered_caches.begin(), m_registered_caches.end());
+        run_postprocessing_jobs(caches.size(), [&caches, &t_function](size_t t_index, int t_thread) {
+            t_function(caches[t_index], t_thread);
+        });
+    }
 
-                for (const auto &kv : access.get()) {
-                    const std::unique_ptr<misa_serializable> &attachment_ptr = kv.second;
+    void misa_runtime_impl::register_cache(std::shared_ptr<misa_cache> t_cache) {
+        if (m_registered_caches.insert(t_cache).second && is_streaming_samples()) {
+            m_unsorted_caches.push_back(std::move(t_cache));
+        }
+    }
 
-                    if (!cache_attachment_path.empty()) {
-                        // Export the attachment as JSON
-                        attachment_ptr->to_json(exported_json[attachment_ptr->get_serialization_id().get_id()]);
+    void misa_runtime_impl::sort_sample_caches() {
+        for (std::shared_ptr<misa_cache> &ptr : m_unsorted_caches) {
+            // Caches might have been unregistered in the meantime
+            if (m_registered_caches.count(ptr) == 0)
+                continue;
+            const boost::filesystem::path internal_path = ptr->get_internal_location();
+            auto it = internal_path.begin();
+            if (it == internal_path.end() || ++it == internal_path.end())
+                continue;
+            m_sample_caches[it->string()].push_back(std::move(ptr));
+        }
+        m_unsorted_caches.clear();
+    }
 
-                        // Export attachment JSON schema
-                        if (attachment_schemata.find(attachment_ptr->get_serialization_id().get_id()) ==
-                            attachment_schemata.end()) {
-                            auto schema = std::make_shared<misa_json_schema_property>();
-                            attachment_ptr->to_json_schema(*schema);
-                            schema->to_json(attachment_schemata[attachment_ptr->get_serialization_id().get_id()]);
-                        }
+    void misa_runtime_impl::release_finished_samples() {
+        remove_postprocessed_samples();
+        if (m_finished_samples.empty())
+            return;
+        std::vector<misa_work_node *> samples;
+        std::swap(samples, m_finished_samples);
+
+        sort_sample_caches();
+        for (misa_work_node *sample : samples) {
+            // Unregister the caches of the sample. They are only referenced by the post-processing job from now on.
+            std::vector<std::shared_ptr<misa_cache>> caches;
+            auto sample_caches = m_sample_caches.find(sample->get_name());
+            if (sample_caches != m_sample_caches.end()) {
+                for (std::shared_ptr<misa_cache> &ptr : sample_caches->second) {
+                    if (m_registered_caches.erase(ptr) > 0) {
+                        caches.push_back(std::move(ptr));
                     }
                 }
+                m_sample_caches.erase(sample_caches);
+            }
 
-                // Attach the location
-                ptr->get_location_interface()->to_json(exported_json["location"]);
-
-                // Add schema for location type if needed
-                if(attachment_schemata.find( ptr->get_location_interface()->get_serialization_id().get_id()) ==
-                   attachment_schemata.end()) {
-                    auto schema = std::make_shared<misa_json_schema_property>();
-                    ptr->get_location_interface()->to_json_schema(*schema);
-                    schema->to_json(attachment_schemata[ptr->get_location_interface()->get_serialization_id().get_id()]);
+            misaxx::utils::log_message(misaxx::utils::log_level::debug) << "[Caches] Sample " << sample->get_name()
+                    << " finished. Post-processing and exporting " << caches.size() << " caches ...";
+            if (!m_pool || caches.empty()) {
+                for (const std::shared_ptr<misa_cache> &ptr : caches) {
+                    postprocess_cache(ptr, 0);
                 }
-
-                // Attach the description storage if needed
-                if (!access.get().has<misa_description_storage>()) {
-                    misa_location link(ptr->get_internal_location(), filesystem_generic_link_path, filesystem_unique_link_path);
-                    ptr->describe()->set_location(ptr->get_location_interface());
-                    ptr->describe()->to_json(exported_json[ptr->describe()->get_serialization_id().get_id()]);
-
-                    // Add schema for description storage if needed
-                    if(attachment_schemata.find( ptr->describe()->get_serialization_id().get_id()) ==
-                       attachment_schemata.end()) {
-                        auto schema = std::make_shared<misa_json_schema_property>();
-                        ptr->describe()->to_json_schema(*schema);
-                        schema->to_json(attachment_schemata[ptr->describe()->get_serialization_id().get_id()]);
-                    }
+                export_cache_attachments(caches, 0);
+                m_postprocessed_samples.push_back(sample->get_name());
+            }
+            else {
+                {
+                    std::lock_guard<std::mutex> lock(m_sample_postprocessing_mutex);
+                    ++m_sample_postprocessing_jobs;
                 }
-
-                // Add schemata for pattern & description
-                if(ptr->describe()->has_pattern()) {
-                    const misa_data_pattern &descr = ptr->describe()->get<misa_data_pattern>();
-                    if(attachment_schemata.find( descr.get_serialization_id().get_id()) ==
-                       attachment_schemata.end()) {
-                        auto schema = std::make_shared<misa_json_schema_property>();
-                        descr.to_json_schema(*schema);
-                        schema->to_json(attachment_schemata[descr.get_serialization_id().get_id()]);
+                m_pool->submit([this, caches = std::move(caches), name = sample->get_name()]() {
+                    const int thread = misaxx::utils::work_stealing_pool::get_current_thread_index();
+                    std::exception_ptr exception;
+                    try {
+                        for (const std::shared_ptr<misa_cache> &ptr : caches) {
+                            postprocess_cache(ptr, thread);
+                        }
+                        export_cache_attachments(caches, thread);
                     }
-                }
-                if(ptr->describe()->has_description()) {
-                    const misa_data_description &descr = ptr->describe()->get<misa_data_description>();
-                    if(attachment_schemata.find( descr.get_serialization_id().get_id()) ==
-                       attachment_schemata.end()) {
-                        auto schema = std::make_shared<misa_json_schema_property>();
-                        descr.to_json_schema(*schema);
-                        schema->to_json(attachment_schemata[descr.get_serialization_id().get_id()]);
+                    catch (...) {
+                        exception = std::current_exception();
                     }
-                }
-
-                if (!m_is_simulating) {
-                    std::ofstream sw;
-                    sw.open(cache_attachment_path.string());
-                    sw << std::setw(4) << exported_json;
-                }
+                    std::lock_guard<std::mutex> lock(m_sample_postprocessing_mutex);
+                    if (exception && !m_sample_postprocessing_exception)
+                        m_sample_postprocessing_exception = exception;
+                    m_postprocessed_samples.push_back(name);
+                    if (--m_sample_postprocessing_jobs == 0) {
+                        m_sample_postprocessing_condition.notify_all();
+                    }
+                });
+            }
 
-                if (m_write_full_runtime_log) {
-                    m_runtime_log.stop(0);
+            // The worker graph needs the whole tree
+            if (m_create_worker_graph)
+                continue;
+            std::vector<misa_work_node *> stack { sample };
+            while (!stack.empty()) {
+                misa_work_node *nd = stack.back();
+                stack.pop_back();
+                m_node_ranks.erase(nd);
+                m_node_threads.erase(nd);
+                for (const auto &child : nd->get_children()) {
+                    stack.push_back(child.get());
                 }
             }
+            sample->get_children().clear();
         }
 
-        // Write attachment serialization IDs
-        if (!m_is_simulating) {
-            const boost::filesystem::path filesystem_export_base_path = get_filesystem().exported->external_path();
-            std::ofstream sw;
-            sw.open((filesystem_export_base_path / "attachments" / "serialization-schemas.json").string());
-            sw << std::setw(4) << attachment_schemata;
+        // Remove the finished samples from the root. Their module instances still reference the caches of the sample.
+        if (!m_create_worker_graph) {
+            const std::unordered_set<misa_work_node *> released(samples.begin(), samples.end());
+            auto &children = m_root->get_children();
+            children.erase(std::remove_if(children.begin(), children.end(), [&](const std::shared_ptr<misa_work_node> &t_child) {
+                return released.count(t_child.get()) > 0;
+            }), children.end());
         }
+    }
 
-        if (!m_write_full_runtime_log) {
-            m_runtime_log.stop(0);
+    void misa_runtime_impl::remove_postprocessed_samples() {
+        std::vector<std::string> samples;
+        {
+            std::lock_guard<std::mutex> lock(m_sample_postprocessing_mutex);
+            std::swap(samples, m_postprocessed_samples);
+        }
+        // The worker graph needs the whole tree
+        if (m_create_worker_graph)
+            return;
+        // The caches already know their locations. Only the root module creates entries in this folder.
+        for (const std::string &sample : samples) {
+            get_filesystem().exported->remove(sample);
+        }
+    }
+
+    void misa_runtime_impl::wait_for_sample_postprocessing() {
+        std::unique_lock<std::mutex> lock(m_sample_postprocessing_mutex);
+        m_sample_postprocessing_condition.wait(lock, [this]() { return m_sample_postprocessing_jobs == 0; });
+        if (m_sample_postprocessing_exception) {
+            std::exception_ptr exception = m_sample_postprocessing_exception;
+            m_sample_postprocessing_exception = nullptr;
+            std::rethrow_exception(exception);
+        }
+    }
+
+    void misa_runtime_impl::postprocess_cache(const std::shared_ptr<misa_cache> &t_cache, int t_thread) {
+        if (m_write_full_runtime_log) {
+            m_runtime_log.start(t_thread, "Postprocessing " + t_cache->get_location().string() + " (" +
+                                   t_cache->get_unique_location().string() + ")");
+        }
+        misaxx::utils::log_message(misaxx::utils::log_level::debug) << "[Caches] Post-processing cache " << t_cache->get_location() << " (" << t_cache->get_unique_location() << ")";
+        t_cache->postprocess();
+        if (t_cache->has_data()) {
+            misaxx::utils::log_message(misaxx::utils::log_level::info) << "[Caches] Info: " << t_cache->get_location() << " (" << t_cache->get_unique_location() << ")" << " reports that it still contains data";
+        }
+        if (m_write_full_runtime_log) {
+            m_runtime_log.stop(t_thread);
+        }
+    }
+
+    void misa_runtime_impl::postprocess_caches() {
+        if (!m_is_simulating) {
+            wait_for_sample_postprocessing();
+            misaxx::utils::log_message(misaxx::utils::log_level::info) << "[Caches] Post-processing caches ...";
+            if (!m_write_full_runtime_log) {
+                m_runtime_log.start(0, "Postprocessing");
+            }
+            // Caches of finished samples were already post-processed and unregistered during the run
+            for_each_registered_cache([this](const std::shared_ptr<misa_cache> &ptr, int thread) {
+                postprocess_cache(ptr, thread);
+            });
+            if (!m_write_full_runtime_log) {
+                m_runtime_log.stop(0);
+            }
         }
     }
 
@@ -786,9 +1332,10 @@ namespace misaxx {
 //        }
 
         // Save filesystem to parameter schema
-        prepare_make_filesystem_template(get_filesystem().imported);
-        prepare_make_filesystem_template(get_filesystem().exported);
-        get_filesystem().to_json_schema(*(m_parameter_schema_builder->resolve("filesystem")->resolve("json-data")));
+        misa_filesystem &filesystem = m_schema_root->get_or_create_instance()->get_module()->filesystem;
+        prepare_make_filesystem_template(filesystem.imported);
+        prepare_make_filesystem_template(filesystem.exported);
+        filesystem.to_json_schema(*(m_parameter_schema_builder->resolve("filesystem")->resolve("json-data")));
         (*m_parameter_schema_builder)["filesystem"]["source"].define<std::string>("json");
 
         // Workaround: Due to inflexibility with schema generation, manually put "__OBJECT__" nodes into list builders
@@ -807,12 +1354,73 @@ namespace misaxx {
         (*m_parameter_schema_builder)["runtime"]["num-threads"].document_title("Number of threads")
                 .document_description("Changes the number of threads")
                 .declare_optional<int>(1);
+        (*m_parameter_schema_builder)["runtime"]["log-level"].document_title("Log level")
+                .document_description("Verbosity of the log. One of error, warning, info or debug. "
+                                      "The progress of finished workers is reported at most 10 times per second unless the level is debug.")
+                .make_enum<std::string>({ "error", "warning", "info", "debug" })
+                .declare_optional<std::string>("info");
+        (*m_parameter_schema_builder)["runtime"]["memory-budget"].document_title("Memory budget")
+                .document_description("Maximum estimated memory (in MB) of tasks that are working at the same time. "
+                                      "Tasks that do not fit into the budget wait until others finished. 0 disables the limit.")
+                .declare_optional<int>(0);
+        (*m_parameter_schema_builder)["runtime"]["io-slots"].document_title("I/O slots")
+                .document_description("Maximum number of parallelized I/O-bound tasks that are working at the same time. "
+                                      "0 disables the limit.")
+                .declare_optional<int>(0);
+        (*m_parameter_schema_builder)["runtime"]["compute-slots"].document_title("Compute slots")
+                .document_description("Maximum number of parallelized compute-bound tasks that are working at the same time. "
+                                      "0 disables the limit.")
+                .declare_optional<int>(0);
+        (*m_parameter_schema_builder)["runtime"]["batch-duration"].document_title("Batch duration")
+                .document_description("Target runtime (in ms) of batches of small sibling tasks that are run by the same worker thread. "
+                                      "0 disables batching.")
+                .declare_optional<double>(5);
+        (*m_parameter_schema_builder)["runtime"]["task-fusion"].document_title("Task fusion")
+                .document_description("If enabled, a task whose only dependent task has no other dependencies is run by the same worker thread "
+                                      "directly before the dependent. Caches that are declared as output of the task and input of the dependent "
+                                      "stay in memory between both tasks.")
+                .declare_optional<bool>(true);
+        (*m_parameter_schema_builder)["runtime"]["cost-history"].document_title("Runtime history")
+                .document_description("Path to the runtime log of a previous run that was created with the full runtime log. "
+                                      "Workers with the longest estimated remaining runtime are started first.")
+                .declare_optional<std::string>("");
+        (*m_parameter_schema_builder)["runtime"]["shard"].document_title("Shard")
+                .document_description("Processes only the samples of shard i/n (e.g. 0/4). Outputs of all shards are merged.")
+                .declare_optional<std::string>("");
+        (*m_parameter_schema_builder)["runtime"]["work-queue"].document_title("Work queue")
+                .document_description("Directory on a shared filesystem. Processes claim samples one after another "
+                                      "by creating lock files in this directory. Outputs of all processes are merged.")
+                .declare_optional<std::string>("");
+        (*m_parameter_schema_builder)["runtime"]["max-samples-in-flight"].document_title("Maximum samples in flight")
+                .document_description("Maximum number of samples whose workers and caches exist at the same time. "
+                                      "Samples are started one after another. 0 creates all samples up front.")
+                .declare_optional<int>(0);
+        (*m_parameter_schema_builder)["runtime"]["thread-affinity"].document_title("Thread affinity")
+                .document_description("Pins the worker threads to CPUs. 'compact' fills one NUMA node after another, "
+                                      "'scatter' distributes the threads over the NUMA nodes. "
+                                      "Alternatively, a list of CPUs (e.g. 0,2,4-7) can be provided. Empty disables pinning.")
+                .declare_optional<std::string>("");
+        (*m_parameter_schema_builder)["runtime"]["memoization-store"].document_title("Memoization store")
+                .document_description("Directory that stores the outputs of tasks by a fingerprint of their parameters and inputs. "
+                                      "Tasks with a known fingerprint restore their outputs instead of working.")
+                .declare_optional<std::string>("");
         (*m_parameter_schema_builder)["runtime"]["request-skipping"].document_title("Skip existing results")
                 .document_description("Informs algorithms that existing results should not be overwritten")
                 .declare_optional<bool>(false);
         (*m_parameter_schema_builder)["runtime"]["write-worker-graph"].document_title("Export workers as graph")
                 .document_description("Creates a file 'misa-workers.dot' that shows the DAG of workers")
                 .declare_optional<bool>(false);
+        (*m_parameter_schema_builder)["runtime"]["skip-parameter-schema"].document_title("Skip parameter schema")
+                .document_description("If enabled, no parameter schema is written into the results folder. "
+                                      "The parameters are still checked before any work is done.")
+                .declare_optional<bool>(false);
+        (*m_parameter_schema_builder)["runtime"]["parameter-schema-cache"].document_title("Parameter schema cache")
+                .document_description("Directory that stores the parameter schemas of previous runs. The schema is reused if the module version, "
+                                      "the structure of the parameters and the samples did not change.")
+                .declare_optional<std::string>("");
+        (*m_parameter_schema_builder)["runtime"]["trace"].document_title("Trace")
+                .document_description("Writes the start and end of each task, dispatcher steps and cache accesses as Chrome trace (trace.json) into the output directory")
+                .declare_optional<bool>(false);
         (*m_parameter_schema_builder)["runtime"]["full-runtime-log"].document_title("Full runtime log")
                 .document_description("If enabled, the runtime log will contain all individual workers")
                 .declare_optional(false);
@@ -822,6 +1430,14 @@ namespace misaxx {
         (*m_parameter_schema_builder)["runtime"]["postprocessing"]["lazy-write-attachments"].document_title("Only write attachments with actual data")
                 .document_description("If enabled, only non-empty attachment files will be written")
                 .declare_optional(true);
+        (*m_parameter_schema_builder)["runtime"]["attachment-format"].document_title("Attachment format")
+                .document_description("Format of the exported attachment files: json, cbor or msgpack")
+                .make_enum<std::string>({ "json", "cbor", "msgpack" })
+                .declare_optional<std::string>("json");
+        (*m_parameter_schema_builder)["runtime"]["attachment-storage"].document_title("Attachment storage")
+                .document_description("How exported attachments are stored: files (one file per cache) or sample (one attachment store per sample)")
+                .make_enum<std::string>({ "files", "sample" })
+                .declare_optional<std::string>("files");
     }
 
 
@@ -880,6 +1496,70 @@ int misaxx::misa_runtime::get_num_threads() const {
     return m_pimpl->m_num_threads;
 }
 
+int misa_runtime::get_thread_budget() const {
+    return m_pimpl->get_thread_budget();
+}
+
+void misa_runtime::parallel_for(int t_num_jobs, const std::function<void(int)> &t_job) {
+    m_pimpl->parallel_for(t_num_jobs, t_job);
+}
+
+double misa_runtime::get_batch_duration() const {
+    return m_pimpl->m_batch_duration;
+}
+
+bool misa_runtime::is_fusing_tasks() const {
+    return m_pimpl->m_task_fusion;
+}
+
+size_t misaxx::misa_runtime::get_memory_budget() const {
+    return m_pimpl->m_memory_budget;
+}
+
+size_t misa_runtime::get_resource_slots(misa_resource_class t_class) const {
+    return m_pimpl->m_resource_slots.at(static_cast<size_t>(t_class));
+}
+
+const boost::filesystem::path &misa_runtime::get_cost_history_path() const {
+    return m_pimpl->m_cost_history_path;
+}
+
+int misa_runtime::get_shard_index() const {
+    return m_pimpl->m_shard_index;
+}
+
+int misa_runtime::get_shard_count() const {
+    return m_pimpl->m_shard_count;
+}
+
+const boost::filesystem::path &misa_runtime::get_work_queue_path() const {
+    return m_pimpl->m_work_queue_path;
+}
+
+size_t misa_runtime::get_max_samples_in_flight() const {
+    return m_pimpl->m_max_samples_in_flight;
+}
+
+bool misa_runtime::is_sharded() const {
+    return m_pimpl->is_sharded();
+}
+
+std::string misa_runtime::get_shard_id() const {
+    return m_pimpl->get_shard_id();
+}
+
+const boost::filesystem::path &misa_runtime::get_memoization_store_path() const {
+    return m_pimpl->m_memoization_store_path;
+}
+
+misa_memoization_store *misa_runtime::get_memoization_store() const {
+    return m_pimpl->m_memoization_store.get();
+}
+
+const std::string &misa_runtime::get_thread_affinity() const {
+    return m_pimpl->m_thread_affinity;
+}
+
 bool misaxx::misa_runtime::is_simulating() const {
     return m_pimpl->m_is_simulating;
 }
@@ -900,10 +1580,30 @@ bool misaxx::misa_runtime::is_lazily_writing_attachments() const {
     return m_pimpl->m_lazy_write_attachments;
 }
 
+const std::string &misa_runtime::get_attachment_format() const {
+    return m_pimpl->m_attachment_format;
+}
+
+const std::string &misa_runtime::get_attachment_storage() const {
+    return m_pimpl->m_attachment_storage;
+}
+
 bool misa_runtime::is_creating_full_runtime_log() const {
     return m_pimpl->m_write_full_runtime_log;
 }
 
+bool misa_runtime::is_writing_trace() const {
+    return m_pimpl->m_write_trace;
+}
+
+bool misa_runtime::is_skipping_parameter_schema() const {
+    return m_pimpl->m_skip_parameter_schema;
+}
+
+const boost::filesystem::path &misa_runtime::get_parameter_schema_cache_path() const {
+    return m_pimpl->m_parameter_schema_cache_path;
+}
+
 bool misa_runtime::is_creating_worker_graph() const {
     return m_pimpl->m_create_worker_graph;
 }
@@ -933,7 +1633,7 @@ misa_module_info misa_runtime::get_module_info() {
 }
 
 void misaxx::misa_runtime::register_cache(std::shared_ptr<misaxx::misa_cache> t_cache) {
-    m_pimpl->m_registered_caches.insert(std::move(t_cache));
+    m_pimpl->register_cache(std::move(t_cache));
 }
 
 bool misaxx::misa_runtime::unregister_cache(const std::shared_ptr<misaxx::misa_cache> &t_cache) {
@@ -953,17 +1653,17 @@ nlohmann::json &misaxx::misa_runtime::get_parameters() {
 }
 
 nlohmann::json misaxx::misa_runtime::get_parameter_value(const std::vector<std::string> &t_path) const {
-    nlohmann::json *result = &m_pimpl->m_parameters;
-    for(const auto &key : t_path) {
-        if(result->find(key) == result->end()) {
-            return nlohmann::json { };
-        }
-
-        result = &result->at(key);
+    const nlohmann::json *result = m_pimpl->find_parameter_value(t_path);
+    if(result == nullptr) {
+        return nlohmann::json { };
     }
     return *result;
 }
 
+const nlohmann::json *misaxx::misa_runtime::find_parameter_value(const std::vector<std::string> &t_path) const {
+    return m_pimpl->find_parameter_value(t_path);
+}
+
 void misa_runtime::set_is_simulating(bool value) {
     if (is_running())
         throw std::runtime_error("Cannot change simulation mode while the runtime is working!");
@@ -978,6 +1678,71 @@ void misa_runtime::set_num_threads(int threads) {
     m_pimpl->m_num_threads = threads;
 }
 
+void misa_runtime::set_memory_budget(size_t bytes) {
+    if (is_running())
+        throw std::runtime_error("Cannot change the memory budget while the runtime is working!");
+    m_pimpl->m_memory_budget = bytes;
+}
+
+void misa_runtime::set_resource_slots(misa_resource_class t_class, size_t t_slots) {
+    if (is_running())
+        throw std::runtime_error("Cannot change the resource slots while the runtime is working!");
+    m_pimpl->m_resource_slots.at(static_cast<size_t>(t_class)) = t_slots;
+}
+
+void misa_runtime::set_batch_duration(double ms) {
+    if (is_running())
+        throw std::runtime_error("Cannot change runtime properties while the runtime is working!");
+    m_pimpl->m_batch_duration = ms;
+}
+
+void misa_runtime::set_task_fusion(bool value) {
+    if (is_running())
+        throw std::runtime_error("Cannot change runtime properties while the runtime is working!");
+    m_pimpl->m_task_fusion = value;
+}
+
+void misa_runtime::set_cost_history_path(const boost::filesystem::path &path) {
+    if (is_running())
+        throw std::runtime_error("Cannot change runtime properties while the runtime is working!");
+    m_pimpl->m_cost_history_path = path;
+}
+
+void misa_runtime::set_shard(int index, int count) {
+    if (is_running())
+        throw std::runtime_error("Cannot change runtime properties while the runtime is working!");
+    if (count < 1 || index < 0 || index >= count)
+        throw std::runtime_error("Invalid shard " + std::to_string(index) + "/" + std::to_string(count) + "!");
+    m_pimpl->m_shard_index = index;
+    m_pimpl->m_shard_count = count;
+}
+
+void misa_runtime::set_work_queue_path(const boost::filesystem::path &path) {
+    if (is_running())
+        throw std::runtime_error("Cannot change runtime properties while the runtime is working!");
+    m_pimpl->m_work_queue_path = path;
+}
+
+void misa_runtime::set_max_samples_in_flight(size_t count) {
+    if (is_running())
+        throw std::runtime_error("Cannot change runtime properties while the runtime is working!");
+    m_pimpl->m_max_samples_in_flight = count;
+}
+
+void misa_runtime::set_memoization_store_path(const boost::filesystem::path &path) {
+    if (is_running())
+        throw std::runtime_error("Cannot change runtime properties while the runtime is working!");
+    m_pimpl->m_memoization_store_path = path;
+}
+
+void misa_runtime::set_thread_affinity(const std::string &value) {
+    if (is_running())
+        throw std::runtime_error("Cannot change runtime properties while the runtime is working!");
+    // Validate the value early
+    misaxx::utils::get_thread_affinity(value, 1);
+    m_pimpl->m_thread_affinity = value;
+}
+
 void misa_runtime::set_write_attachments(bool value) {
     if (is_running())
         throw std::runtime_error("Cannot change runtime properties while the runtime is working!");
@@ -990,6 +1755,40 @@ void misa_runtime::set_lazy_write_attachments(bool value) {
     m_pimpl->m_lazy_write_attachments = value;
 }
 
+void misa_runtime::set_attachment_format(const std::string &value) {
+    if (is_running())
+        throw std::runtime_error("Cannot change runtime properties while the runtime is working!");
+    // Validate the value early
+    misaxx::utils::parse_json_format(value);
+    m_pimpl->m_attachment_format = value;
+}
+
+void misa_runtime::set_attachment_storage(const std::string &value) {
+    if (is_running())
+        throw std::runtime_error("Cannot change runtime properties while the runtime is working!");
+    if (value != "files" && value != "sample")
+        throw std::runtime_error("Unknown attachment storage " + value + "! Supported are files and sample.");
+    m_pimpl->m_attachment_storage = value;
+}
+
+void misa_runtime::set_skip_parameter_schema(bool value) {
+    if(is_running())
+        throw std::runtime_error("Cannot change runtime properties while the runtime is working!");
+    m_pimpl->m_skip_parameter_schema = value;
+}
+
+void misa_runtime::set_parameter_schema_cache_path(const boost::filesystem::path &path) {
+    if(is_running())
+        throw std::runtime_error("Cannot change runtime properties while the runtime is working!");
+    m_pimpl->m_parameter_schema_cache_path = path;
+}
+
+void misa_runtime::set_write_trace(bool value) {
+    if(is_running())
+        throw std::runtime_error("Cannot change runtime properties while the runtime is working!");
+    m_pimpl->m_write_trace = value;
+}
+
 void misa_runtime::set_enable_full_runtime_log(bool value) {
     if (is_running())
         throw std::runtime_error("Cannot change runtime properties while the runtime is working!");
@@ -1048,8 +1847,17 @@ void misa_runtime::set_schema_root_node(std::shared_ptr<misa_work_node> schema_r
     m_pimpl->m_schema_root = std::move(schema_root);
 }
 
+void misa_runtime::add_start_hook(std::function<void(misa_runtime &)> t_hook) {
+    if (is_running())
+        throw std::runtime_error("Cannot change runtime properties while the runtime is working!");
+    m_pimpl->m_start_hooks.push_back(std::move(t_hook));
+}
+
 void misaxx::misa_runtime::prepare_and_run() {
     load_filesystem(*m_pimpl);
+    for (const auto &hook : m_pimpl->m_start_hooks) {
+        hook(*this);
+    }
     m_pimpl->run();
 }
 
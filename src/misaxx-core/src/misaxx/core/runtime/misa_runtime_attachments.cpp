@@ -0,0 +1,250 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#include <fstream>
+#include "misa_runtime_impl.h"
+
+namespace {
+    /**
+     * Number of members written by misa_runtime_impl::write_cache_attachments()
+     * @param t_attachments
+     * @return
+     */
+    size_t get_num_attachment_members(const misaxx::misa_cached_data_base::attachment_type &t_attachments) {
+        size_t result = t_attachments.has<misaxx::misa_description_storage>() ? 1 : 2; // Location and description storage
+        for (auto it = t_attachments.begin(); it != t_attachments.end(); ++it) {
+            ++result;
+        }
+        return result;
+    }
+}
+
+namespace misaxx {
+    void misa_runtime_impl::write_cache_attachments(const std::shared_ptr<misa_cache> &t_cache,
+                                                    const misa_cached_data_base::attachment_type &t_attachments,
+                                                    misaxx::utils::json_object_writer &t_writer,
+                                                    const std::function<void(const misa_serializable &)> &t_add_schema) {
+        boost::filesystem::path filesystem_unique_link_path = t_cache->get_internal_unique_location();
+        boost::filesystem::path filesystem_generic_link_path = t_cache->get_internal_location();
+
+        for (const auto &kv : t_attachments) {
+            const std::unique_ptr<misa_serializable> &attachment_ptr = kv.second;
+
+            // Export the attachment as JSON
+            nlohmann::json attachment_json;
+            attachment_ptr->to_json(attachment_json);
+            t_writer.write(attachment_ptr->get_serialization_id().get_id(), attachment_json);
+
+            // Export attachment JSON schema
+            t_add_schema(*attachment_ptr);
+        }
+
+        // Attach the location
+        {
+            nlohmann::json location_json;
+            t_cache->get_location_interface()->to_json(location_json);
+            t_writer.write("location", location_json);
+        }
+
+        // Add schema for location type if needed
+        t_add_schema(*t_cache->get_location_interface());
+
+        // Attach the description storage if needed
+        if (!t_attachments.has<misa_description_storage>()) {
+            misa_location link(t_cache->get_internal_location(), filesystem_generic_link_path, filesystem_unique_link_path);
+            t_cache->describe()->set_location(t_cache->get_location_interface());
+            nlohmann::json description_json;
+            t_cache->describe()->to_json(description_json);
+            t_writer.write(t_cache->describe()->get_serialization_id().get_id(), description_json);
+
+            // Add schema for description storage if needed
+            t_add_schema(*t_cache->describe());
+        }
+
+        // Add schemata for pattern & description
+        if(t_cache->describe()->has_pattern()) {
+            t_add_schema(t_cache->describe()->get<misa_data_pattern>());
+        }
+        if(t_cache->describe()->has_description()) {
+            t_add_schema(t_cache->describe()->get<misa_data_description>());
+        }
+    }
+
+    void misa_runtime_impl::add_attachment_schema(const misa_serializable &t_serializable) {
+        const std::string id = t_serializable.get_serialization_id().get_id();
+        std::lock_guard<std::mutex> lock(m_attachment_schemata_mutex);
+        if (m_attachment_schemata.find(id) == m_attachment_schemata.end()) {
+            auto schema = std::make_shared<misa_json_schema_property>();
+            t_serializable.to_json_schema(*schema);
+            schema->to_json(m_attachment_schemata[id]);
+        }
+    }
+
+    std::map<boost::filesystem::path, std::vector<std::shared_ptr<misa_cache>>>
+    misa_runtime_impl::get_attachment_stores(const std::vector<std::shared_ptr<misa_cache>> &t_caches) const {
+        // Group the caches by their sample folder (e.g. exported/<sample>)
+        std::map<boost::filesystem::path, std::vector<std::shared_ptr<misa_cache>>> groups;
+        for (const std::shared_ptr<misa_cache> &ptr : t_caches) {
+            if (ptr->get_unique_location().empty())
+                continue;
+            const boost::filesystem::path internal_path = ptr->get_internal_unique_location();
+            boost::filesystem::path group;
+            int depth = 0;
+            for (auto it = internal_path.begin(); it != internal_path.end() && depth < 2; ++it, ++depth) {
+                group /= *it;
+            }
+            if (group == internal_path) {
+                group = internal_path.parent_path();
+            }
+            groups[group].push_back(ptr);
+        }
+        return groups;
+    }
+
+    void misa_runtime_impl::write_attachment_store(const boost::filesystem::path &t_group,
+                                                   const std::vector<std::shared_ptr<misa_cache>> &t_caches, int t_thread) {
+        std::vector<std::shared_ptr<misa_cache>> caches;
+        for (const std::shared_ptr<misa_cache> &ptr : t_caches) {
+            if (!m_lazy_write_attachments || !readonly_access<typename misa_cached_data_base::attachment_type>(ptr->attachments).get().empty()) {
+                caches.push_back(ptr);
+            }
+        }
+        if (caches.empty())
+            return;
+
+        if (m_write_full_runtime_log) {
+            m_runtime_log.start(t_thread, "Attachments: " + t_group.string());
+        }
+
+        misaxx::utils::log_message(misaxx::utils::log_level::debug) << "[Attachments] Post-processing attachment store " << t_group << " (" << caches.size() << " caches)";
+
+        const misaxx::utils::json_format attachment_format = misaxx::utils::parse_json_format(m_attachment_format);
+        const std::string attachment_extension = misaxx::utils::get_json_format_extension(attachment_format);
+        const boost::filesystem::path store_path = get_filesystem().exported->external_path() / "attachments" / t_group / ("attachment-store" + attachment_extension);
+        boost::filesystem::create_directories(store_path.parent_path());
+
+        // Each cache is a member named after its attachment file relative to the sample folder
+        std::ofstream sw;
+        sw.open(store_path.string(), std::ios::out | std::ios::binary);
+        misaxx::utils::json_object_writer writer(sw, attachment_format, caches.size());
+        for (const std::shared_ptr<misa_cache> &ptr : caches) {
+            readonly_access<typename misa_cached_data_base::attachment_type> access(ptr->attachments);
+            const boost::filesystem::path key = boost::filesystem::path(ptr->get_internal_unique_location()).lexically_relative(t_group);
+            writer.begin_object(key.generic_string() + attachment_extension, get_num_attachment_members(access.get()));
+            write_cache_attachments(ptr, access.get(), writer, [this](const misa_serializable &t_serializable) {
+                add_attachment_schema(t_serializable);
+            });
+            writer.end_object();
+        }
+        writer.close();
+
+        if (m_write_full_runtime_log) {
+            m_runtime_log.stop(t_thread);
+        }
+    }
+
+    void misa_runtime_impl::write_attachment_file(const std::shared_ptr<misa_cache> &t_cache, int t_thread) {
+        if (t_cache->get_unique_location().empty())
+            return;
+
+        readonly_access<typename misa_cached_data_base::attachment_type> access(t_cache->attachments); // Open the cache
+
+        if (m_lazy_write_attachments && access.get().empty()) {
+            return;
+        }
+
+        if (m_write_full_runtime_log) {
+            m_runtime_log.start(t_thread, "Attachments: " + t_cache->get_location().string() + " (" +
+                                   t_cache->get_unique_location().string() + ")");
+        }
+
+        misaxx::utils::log_message(misaxx::utils::log_level::debug) << "[Attachments] Post-processing attachment " << t_cache->get_location() << " (" << t_cache->get_unique_location() << ")";
+
+        // Replace extension with the attachment format
+        const misaxx::utils::json_format attachment_format = misaxx::utils::parse_json_format(m_attachment_format);
+        const std::string attachment_extension = misaxx::utils::get_json_format_extension(attachment_format);
+        boost::filesystem::path cache_attachment_path =
+                (get_filesystem().exported->external_path() / "attachments" / t_cache->get_internal_unique_location()).string() + attachment_extension;
+        boost::filesystem::create_directories(cache_attachment_path.parent_path());
+
+        // Write the attachments one after another instead of building the whole JSON first
+        std::ofstream sw;
+        sw.open(cache_attachment_path.string(), std::ios::out | std::ios::binary);
+        misaxx::utils::json_object_writer writer(sw, attachment_format, get_num_attachment_members(access.get()));
+        write_cache_attachments(t_cache, access.get(), writer, [this](const misa_serializable &t_serializable) {
+            add_attachment_schema(t_serializable);
+        });
+        writer.close();
+
+        if (m_write_full_runtime_log) {
+            m_runtime_log.stop(t_thread);
+        }
+    }
+
+    void misa_runtime_impl::export_cache_attachments(const std::vector<std::shared_ptr<misa_cache>> &t_caches, int t_thread) {
+        if (!m_write_attachments)
+            return;
+        if (m_attachment_storage == "sample") {
+            for (const auto &kv : get_attachment_stores(t_caches)) {
+                write_attachment_store(kv.first, kv.second, t_thread);
+            }
+        }
+        else {
+            for (const std::shared_ptr<misa_cache> &ptr : t_caches) {
+                write_attachment_file(ptr, t_thread);
+            }
+        }
+
+        // The caches are not referenced by the runtime anymore. Free the attachments in case a task still holds the cache.
+        for (const std::shared_ptr<misa_cache> &ptr : t_caches) {
+            readwrite_access<typename misa_cached_data_base::attachment_type> access(ptr->attachments);
+            access.get().clear();
+        }
+    }
+
+    void misa_runtime_impl::postprocess_cache_attachments() {
+        if (!m_write_attachments) {
+            misaxx::utils::log_message(misaxx::utils::log_level::info) << "[Attachments] Post-processing attachments ... Skipped";
+            return;
+        }
+
+        misaxx::utils::log_message(misaxx::utils::log_level::info) << "[Attachments] Post-processing attachments ...";
+
+        if (!m_write_full_runtime_log) {
+            m_runtime_log.start(0, "Attachments");
+        }
+
+        // Attachments of finished samples were already exported during the run
+        if (!m_is_simulating) {
+            if (m_attachment_storage == "sample") {
+                const std::vector<std::shared_ptr<misa_cache>> caches(m_registered_caches.begin(), m_registered_caches.end());
+                const auto groups = get_attachment_stores(caches);
+                const std::vector<std::pair<boost::filesystem::path, std::vector<std::shared_ptr<misa_cache>>>> group_list(groups.begin(), groups.end());
+                run_postprocessing_jobs(group_list.size(), [&](size_t t_index, int thread) {
+                    write_attachment_store(group_list[t_index].first, group_list[t_index].second, thread);
+                });
+            }
+            else {
+                for_each_registered_cache([this](const std::shared_ptr<misa_cache> &ptr, int thread) {
+                    write_attachment_file(ptr, thread);
+                });
+            }
+
+            // Write attachment serialization IDs
+            write_output_json(get_filesystem().exported->external_path() / "attachments" / "serialization-schemas.json", std::move(m_attachment_schemata));
+        }
+
+        if (!m_write_full_runtime_log) {
+            m_runtime_log.stop(0);
+        }
+    }
+}
@@ -0,0 +1,248 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#include <misaxx/core/utils/string.h>
+#include <misaxx/core/utils/trace.h>
+#include <algorithm>
+#include "misa_runtime_impl.h"
+#include "../workers/misa_work_barrier.h"
+
+namespace misaxx {
+    void misa_runtime_impl::start_batch(std::vector<misa_work_node *> t_batch) {
+        // Each task is followed by its chain of fused successors
+        struct batch_entry {
+            misa_work_node *node;
+            /**
+             * Task that runs directly before a fused successor (nullptr if the node is not fused)
+             */
+            misa_work_node *predecessor;
+            /**
+             * Caches that are kept in memory between the predecessor and the fused successor
+             */
+            std::vector<std::shared_ptr<misa_cache>> retained;
+        };
+        std::vector<batch_entry> entries;
+        entries.reserve(t_batch.size());
+        for (misa_work_node *nd : t_batch) {
+            entries.push_back(batch_entry { nd, nullptr, {} });
+            misa_work_node *predecessor = nd;
+            // Last task before the successor. Barriers in between do not touch any cache.
+            std::shared_ptr<misa_task> producer = std::dynamic_pointer_cast<misa_task>(nd->get_instance());
+            while (misa_work_node *successor = get_fusable_successor(predecessor)) {
+                m_fused_nodes.insert(successor);
+                m_fused_successors[predecessor] = successor;
+                progress(*successor, "Info: Fusing with its dependency", misaxx::utils::log_level::debug);
+
+                batch_entry entry { successor, predecessor, {} };
+                const auto task = std::dynamic_pointer_cast<misa_task>(successor->get_instance());
+                if (static_cast<bool>(task)) {
+                    const auto &outputs = producer->get_cache_usage().outputs;
+                    const auto &inputs = task->get_cache_usage().inputs;
+                    for (const auto &cache : outputs) {
+                        if (std::find(inputs.begin(), inputs.end(), cache) != inputs.end()) {
+                            cache->retain();
+                            entry.retained.push_back(cache);
+                        }
+                    }
+                    producer = task;
+                }
+                entries.emplace_back(std::move(entry));
+                predecessor = successor;
+            }
+        }
+
+        m_nodes_running += entries.size();
+        const int preferred_thread = get_preferred_thread(t_batch.front());
+        m_pool->submit([this, batch = std::move(entries)]() {
+            const int thread = misaxx::utils::work_stealing_pool::get_current_thread_index();
+            std::vector<worked_node> worked;
+            worked.reserve(batch.size());
+            ++m_threads_working;
+            try {
+                bool skip_successors = false;
+                for (const batch_entry &entry : batch) {
+                    misa_work_node *nd = entry.node;
+                    if (entry.predecessor != nullptr) {
+                        // The successor is skipped if its predecessor rejected its work
+                        skip_successors |= entry.predecessor->get_worker_status() == misa_worker_status::queued_repeat;
+                        if (skip_successors) {
+                            for (const auto &cache : entry.retained) {
+                                cache->release();
+                            }
+                            continue;
+                        }
+                    } else {
+                        skip_successors = false;
+                    }
+                    if (m_write_full_runtime_log) {
+                        m_runtime_log.start(thread, misaxx::utils::to_string(*nd->get_global_path()));
+                    }
+                    misaxx::utils::trace_span span("worker", get_trace_name(*nd));
+                    const auto start = std::chrono::steady_clock::now();
+                    nd->work();
+                    const std::chrono::duration<double, std::milli> runtime = std::chrono::steady_clock::now() - start;
+                    if (m_write_full_runtime_log) {
+                        m_runtime_log.stop(thread);
+                    }
+                    for (const auto &cache : entry.retained) {
+                        cache->release();
+                    }
+                    worked.push_back(worked_node { nd, runtime.count(), thread });
+                }
+            }
+            catch (...) {
+                --m_threads_working;
+                finish_dispatcher(std::current_exception());
+                return;
+            }
+            --m_threads_working;
+            {
+                std::lock_guard<std::mutex> lock(m_nodes_worked_mutex);
+                m_nodes_worked.insert(m_nodes_worked.end(), worked.begin(), worked.end());
+            }
+            schedule_dispatcher();
+        }, preferred_thread);
+    }
+
+    misa_work_node *misa_runtime_impl::get_fusable_successor(misa_work_node *t_node) {
+        if (!m_task_fusion || t_node->get_dependents().size() != 1)
+            return nullptr;
+        if (dynamic_cast<misa_task *>(t_node->get_instance().get()) == nullptr && !is_transparent_barrier(t_node))
+            return nullptr;
+        misa_work_node *successor = t_node->get_dependents().front();
+        // A successor is already prepared if it could not be fused before its dependency rejected its work
+        const misa_worker_status status = successor->get_worker_status();
+        if (successor->get_dependencies().size() != 1 || (status != misa_worker_status::undone && status != misa_worker_status::ready))
+            return nullptr;
+        if (is_transparent_barrier(successor)) {
+            // Barriers of whole groups are finished by the dispatcher
+            if (successor->get_dependents().size() != 1)
+                return nullptr;
+            if (status == misa_worker_status::undone) {
+                successor->prepare_work();
+            }
+            return successor;
+        }
+        if (!successor->is_parallelizeable() || dynamic_cast<misa_task *>(successor->get_instance().get()) == nullptr)
+            return nullptr;
+        if (status == misa_worker_status::undone) {
+            successor->prepare_work();
+        }
+        // Successors with a memory estimate have to wait for the budget in the ready queue
+        if (get_memory_estimate(successor) > 0)
+            return nullptr;
+        // The successor uses the resource slot of the task
+        if (get_resource_class(successor) != get_resource_class(t_node))
+            return nullptr;
+        return successor;
+    }
+
+    bool misa_runtime_impl::is_transparent_barrier(const misa_work_node *t_node) {
+        return t_node->get_dependencies().size() == 1 &&
+               dynamic_cast<misa_work_barrier *>(t_node->get_instance().get()) != nullptr;
+    }
+
+    void misa_runtime_impl::unfuse_successors(misa_work_node *t_node) {
+        auto it = m_fused_successors.find(t_node);
+        while (it != m_fused_successors.end()) {
+            misa_work_node *successor = it->second;
+            m_fused_successors.erase(it);
+            m_fused_nodes.erase(successor);
+            --m_nodes_running;
+            it = m_fused_successors.find(successor);
+        }
+    }
+
+    std::vector<misa_work_node *> misa_runtime_impl::collect_batch(misa_work_node *t_node) {
+        std::vector<misa_work_node *> batch { t_node };
+        if (m_batch_duration <= 0 || t_node->get_worker_status() == misa_worker_status::queued_repeat)
+            return batch;
+        if (dynamic_cast<misa_task *>(t_node->get_instance().get()) == nullptr)
+            return batch;
+
+        // Only tasks that are much shorter than the target are batched
+        const double cost = get_batch_cost(t_node);
+        if (cost <= 0 || cost * 2 > m_batch_duration)
+            return batch;
+
+        // Leave enough ready nodes for the other threads
+        const auto num_threads = static_cast<size_t>(m_pool->get_num_threads());
+        const size_t max_size = std::min(static_cast<size_t>(m_batch_duration / cost),
+                                         std::max<size_t>(1, (m_nodes_ready.size() + 1) / num_threads));
+
+        const auto parent = t_node->get_parent().lock();
+        const auto &algorithm_path = t_node->get_algorithm_path()->get_path();
+        while (batch.size() < max_size && !m_nodes_ready.empty()) {
+            misa_work_node *nd = m_nodes_ready.top().node;
+            if (nd->get_worker_status() == misa_worker_status::queued_repeat || !nd->is_parallelizeable() ||
+                nd->get_parent().lock() != parent || nd->get_algorithm_path()->get_path() != algorithm_path) {
+                break;
+            }
+            m_nodes_ready.pop();
+            if (nd->get_worker_status() != misa_worker_status::ready) {
+                nd->prepare_work();
+            }
+            // The batch runs with the resource slot of the first task
+            if (get_memory_estimate(nd) > 0 || get_resource_class(nd) != get_resource_class(t_node)) {
+                push_ready(nd);
+                break;
+            }
+            batch.push_back(nd);
+        }
+        return batch;
+    }
+
+    bool misa_runtime_impl::wait_for_measurement(misa_work_node *t_node) {
+        if (m_batch_duration <= 0 || t_node->get_worker_status() == misa_worker_status::queued_repeat || !t_node->is_parallelizeable())
+            return false;
+        if (dynamic_cast<misa_task *>(t_node->get_instance().get()) == nullptr || get_batch_cost(t_node) > 0)
+            return false;
+        // Nodes that waited for a resource slot are already measuring
+        if (m_measuring_nodes.count(t_node) > 0)
+            return false;
+
+        auto path = misaxx::utils::to_string(*t_node->get_algorithm_path());
+        auto &waiting = m_nodes_waiting_for_measurement[path];
+        if (waiting.first < static_cast<size_t>(m_pool->get_num_threads())) {
+            ++waiting.first;
+            m_measuring_nodes[t_node] = std::move(path);
+            return false;
+        }
+        waiting.second.push_back(t_node);
+        return true;
+    }
+
+    void misa_runtime_impl::finish_measurement(misa_work_node *t_node) {
+        auto it = m_measuring_nodes.find(t_node);
+        if (it == m_measuring_nodes.end())
+            return;
+        auto waiting = m_nodes_waiting_for_measurement.find(it->second);
+        for (misa_work_node *nd : waiting->second.second) {
+            push_ready(nd);
+        }
+        waiting->second.second.clear();
+        if (--waiting->second.first == 0) {
+            m_nodes_waiting_for_measurement.erase(waiting);
+        }
+        m_measuring_nodes.erase(it);
+    }
+
+    double misa_runtime_impl::get_batch_cost(misa_work_node *t_node) const {
+        const double cost = get_cost(t_node);
+        if (cost > 0)
+            return cost;
+        auto it = m_measured_costs.find(misaxx::utils::to_string(*t_node->get_algorithm_path()));
+        if (it == m_measured_costs.end())
+            return 0;
+        return it->second.first / it->second.second;
+    }
+}
@@ -0,0 +1,66 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#include <fstream>
+#include <boost/filesystem/operations.hpp>
+#include <nlohmann/json.hpp>
+#include "misa_runtime_cost_history.h"
+
+using namespace misaxx;
+
+void misa_runtime_cost_history::load(const boost::filesystem::path &t_path) {
+    if(!boost::filesystem::exists(t_path))
+        throw std::runtime_error("The runtime log " + t_path.string() + " does not exist!");
+
+    nlohmann::json json;
+    {
+        std::ifstream in { t_path.string() };
+        in >> json;
+    }
+    if(json.find("entries") == json.end())
+        return;
+
+    for(const auto &thread : json["entries"].items()) {
+        for(const auto &entry : thread.value()) {
+            const auto name = entry["name"].get<std::string>();
+            const double duration = entry["end-time"].get<double>() - entry["start-time"].get<double>();
+
+            record &r = m_costs[name];
+            r.total += duration;
+            ++r.count;
+
+            // Each worker also contributes to the subtree of its ancestors
+            for(size_t separator = name.find('/'); separator != std::string::npos; separator = name.find('/', separator + 1)) {
+                m_subtree_costs[name.substr(0, separator)] += duration;
+            }
+            m_subtree_costs[name] += duration;
+        }
+    }
+}
+
+bool misa_runtime_cost_history::empty() const {
+    return m_costs.empty();
+}
+
+double misa_runtime_cost_history::get_cost(const std::string &t_path) const {
+    auto it = m_costs.find(t_path);
+    if(it == m_costs.end())
+        return 0;
+    return it->second.total / it->second.count;
+}
+
+double misa_runtime_cost_history::get_subtree_cost(const std::string &t_path) const {
+    auto it = m_subtree_costs.find(t_path);
+    if(it == m_subtree_costs.end())
+        return 0;
+    return it->second;
+}
@@ -0,0 +1,67 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <boost/filesystem/path.hpp>
+
+namespace misaxx {
+
+    /**
+     * Runtimes of workers that were recorded in the runtime log of a previous run.
+     * Workers are identified by their global path.
+     */
+    class misa_runtime_cost_history {
+    public:
+
+        /**
+         * Loads a runtime-log.json file
+         * Only logs that were created with the full runtime log contain information about individual workers.
+         * @param t_path
+         */
+        void load(const boost::filesystem::path &t_path);
+
+        /**
+         * Returns true if no worker runtimes are known
+         * @return
+         */
+        bool empty() const;
+
+        /**
+         * Returns the average runtime (in ms) of workers with the given global path or 0 if it is unknown
+         * @param t_path
+         * @return
+         */
+        double get_cost(const std::string &t_path) const;
+
+        /**
+         * Returns the summed runtime (in ms) of all workers within the subtree at the given global path
+         * or 0 if it is unknown
+         * @param t_path
+         * @return
+         */
+        double get_subtree_cost(const std::string &t_path) const;
+
+    private:
+
+        struct record {
+            double total = 0;
+            size_t count = 0;
+        };
+
+        std::unordered_map<std::string, record> m_costs;
+
+        std::unordered_map<std::string, double> m_subtree_costs;
+    };
+}
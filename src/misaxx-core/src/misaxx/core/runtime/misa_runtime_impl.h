@@ -0,0 +1,961 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#pragma once
+
+#include <misaxx/core/runtime/misa_runtime.h>
+#include <misaxx/core/runtime/misa_runtime_log.h>
+#include <misaxx/core/misa_cached_data.h>
+#include <misaxx/core/misa_task.h>
+#include <misaxx/core/utils/work_stealing_pool.h>
+#include <misaxx/core/utils/log.h>
+#include <misaxx/core/utils/json_io.h>
+#include <condition_variable>
+#include <chrono>
+#include <deque>
+#include <array>
+#include <queue>
+#include <map>
+#include "misa_runtime_cost_history.h"
+#include "misa_memoization_store.h"
+
+namespace misaxx {
+    /**
+     * Implementation of misa_runtime.
+     * The scheduling policies are defined in misa_runtime_resources.cpp (memory budget and resource slots),
+     * misa_runtime_batching.cpp (batching and task fusion) and misa_runtime_locality.cpp (order of the ready queue).
+     * The attachments are exported in misa_runtime_attachments.cpp
+     */
+    struct misa_runtime_impl {
+    public:
+
+        misa_module_info m_module_info;
+
+        std::shared_ptr<misa_work_node> m_root;
+
+        std::shared_ptr<misa_work_node> m_schema_root;
+
+        /**
+         * Functions that are called before the workload is started
+         */
+        std::vector<std::function<void(misa_runtime &)>> m_start_hooks;
+
+        std::unordered_set<std::shared_ptr<misa_cache>> m_registered_caches;
+
+        /**
+         * Caches that were registered since the last call of sort_sample_caches()
+         * Only used if samples are streamed
+         */
+        std::vector<std::shared_ptr<misa_cache>> m_unsorted_caches;
+
+        /**
+         * Registered caches of each sample that did not finish yet
+         * Only used if samples are streamed
+         */
+        std::unordered_map<std::string, std::vector<std::shared_ptr<misa_cache>>> m_sample_caches;
+
+        /**
+         * JSON schemas of the exported attachments by their serialization ID
+         */
+        nlohmann::json m_attachment_schemata;
+
+        std::mutex m_attachment_schemata_mutex;
+
+        /**
+         * Node in the ready queue
+         */
+        struct ready_node {
+            /**
+             * Estimated runtime of the longest path that starts at this node
+             */
+            double rank;
+            /**
+             * Nodes with the same rank are processed in the order they became ready
+             */
+            size_t sequence;
+            misa_work_node *node;
+            /**
+             * Dependency that made the node ready (or nullptr)
+             */
+            misa_work_node *producer;
+            /**
+             * Worker thread that ran the producer (-1 if unknown)
+             */
+            int producer_thread;
+
+            bool operator<(const ready_node &t_other) const {
+                if (rank != t_other.rank)
+                    return rank < t_other.rank;
+                return sequence > t_other.sequence;
+            }
+        };
+
+        /**
+         * Nodes whose dependencies are satisfied and that can start working.
+         * Nodes with the longest remaining path are started first.
+         * Among the first nodes with the same rank, tasks whose input caches hold data are preferred (see pop_ready()).
+         */
+        std::priority_queue<ready_node> m_nodes_ready;
+
+        /**
+         * Number of ready nodes with the same rank that are compared by their locality
+         */
+        static constexpr size_t locality_candidates = 8;
+
+        /**
+         * True if a finished task declared input caches. Until then, ready nodes are not prepared to compare their locality.
+         */
+        bool m_cache_inputs_declared = false;
+
+        size_t m_nodes_ready_sequence = 0;
+
+        /**
+         * Cached ranks of nodes
+         */
+        std::unordered_map<misa_work_node *, double> m_node_ranks;
+
+        /**
+         * Nodes that rejected their work. They are retried as soon as another node finished.
+         */
+        std::vector<misa_work_node *> m_nodes_rejected;
+
+        /**
+         * Number of children that are not finished, yet (for each dispatcher that is waiting for its children)
+         */
+        std::unordered_map<misa_work_node *, size_t> m_unfinished_children;
+
+        /**
+         * Number of nodes that are known to the runtime, but are not finished
+         */
+        size_t m_nodes_pending = 0;
+
+        // Variables are protected and will be set by the inheriting runtime
+
+        bool m_is_simulating = false;
+
+        /**
+         * If true, tasks are requested to skip if the results already exist
+         */
+        bool m_requests_skipping = false;
+
+        /**
+       * Number of threads used by the runtime.
+       * If the number is 1, the application will run in the current thread.
+       */
+        int m_num_threads = 1;
+
+        /**
+         * How the worker threads are pinned to CPUs. See misaxx::utils::get_thread_affinity()
+         */
+        std::string m_thread_affinity;
+
+        /**
+         * Maximum sum of the memory estimates (in bytes) of tasks that are working at the same time.
+         * If the value is 0, the memory is not limited.
+         */
+        size_t m_memory_budget = 0;
+
+        /**
+         * Maximum number of parallelized tasks of each resource class that are working at the same time.
+         * If the value is 0, the number is only limited by the number of threads.
+         */
+        std::array<size_t, 2> m_resource_slots {{ 0, 0 }};
+
+        /**
+         * Target runtime (in ms) of batches of small sibling tasks.
+         * If the value is 0, each task is submitted on its own.
+         */
+        double m_batch_duration = 5;
+
+        /**
+         * If true, tasks are fused with their only dependent task
+         */
+        bool m_task_fusion = true;
+
+        /**
+         * Runtime log of a previous run that is used to estimate the runtime of workers
+         */
+        boost::filesystem::path m_cost_history_path;
+
+        misa_runtime_cost_history m_cost_history;
+
+        /**
+         * Only samples with index % m_shard_count == m_shard_index are processed
+         */
+        int m_shard_index = 0;
+
+        int m_shard_count = 1;
+
+        /**
+         * Directory that contains the lock files of samples that were claimed by a process
+         */
+        boost::filesystem::path m_work_queue_path;
+
+        /**
+         * Maximum number of samples that are materialized at the same time. 0 if all samples are materialized up front.
+         */
+        size_t m_max_samples_in_flight = 0;
+
+        /**
+         * Identifies this process within the shared output directory
+         */
+        std::string m_shard_id;
+
+        /**
+         * Directory of the content-addressed store of task outputs
+         */
+        boost::filesystem::path m_memoization_store_path;
+
+        /**
+         * Memoization store of the current run. Only exists if memoization is enabled.
+         */
+        std::unique_ptr<misa_memoization_store> m_memoization_store;
+
+        /**
+         * If true, write attachments
+         */
+        bool m_write_attachments = true;
+
+        /**
+         * If true, write only attachments with user-generated data
+         * Otherwise, also writes "empty" attachments (containing description storage and location)
+         */
+        bool m_lazy_write_attachments = true;
+
+        /**
+         * Format of the exported attachment files. See misaxx::utils::json_format
+         */
+        std::string m_attachment_format = "json";
+
+        /**
+         * How the exported attachments are stored: "files" (one file per cache) or "sample" (one store per sample)
+         */
+        std::string m_attachment_storage = "files";
+
+        /**
+         * If true, log the start and stop times of each worker
+         */
+        bool m_write_full_runtime_log = false;
+
+        /**
+         * If true, record trace spans of the workers and write them as Chrome trace
+         */
+        bool m_write_trace = false;
+
+        /**
+         * If true, no parameter schema is written into the results folder
+         */
+        bool m_skip_parameter_schema = false;
+
+        /**
+         * Directory that contains parameter schemas of previous runs.
+         * If empty, the parameter schema is always built.
+         */
+        boost::filesystem::path m_parameter_schema_cache_path;
+
+        /**
+         * If true, create a *.dot graph of the workers
+         */
+        bool m_create_worker_graph = false;
+
+        /**
+         * Runtime log
+         */
+        misa_runtime_log m_runtime_log;
+
+        /**
+         * Parameters for the workers
+         */
+        nlohmann::json m_parameters;
+
+        /**
+         * Used to create a configuration schema
+         */
+        std::shared_ptr<misa_json_schema_property> m_parameter_schema_builder;
+
+        misa_runtime_impl();
+
+        void run();
+
+        bool is_running() {
+            return m_nodes_pending > 0;
+        }
+
+        bool is_sharded() const {
+            return m_shard_count > 1 || !m_work_queue_path.empty();
+        }
+
+        const std::string &get_shard_id() {
+            if (m_shard_id.empty()) {
+                if (m_shard_count > 1) {
+                    m_shard_id = "shard" + std::to_string(m_shard_index);
+                } else {
+                    // Processes that use a work queue cannot be distinguished by their index
+                    m_shard_id = "shard-" + boost::filesystem::unique_path("%%%%-%%%%-%%%%").string();
+                }
+            }
+            return m_shard_id;
+        }
+        
+        int get_thread_budget() const;
+
+        void parallel_for(int t_num_jobs, const std::function<void(int)> &t_job);
+
+        /**
+         * Registers a cache. Caches of samples are remembered for release_finished_samples() if samples are streamed.
+         * @param t_cache
+         */
+        void register_cache(std::shared_ptr<misa_cache> t_cache);
+
+        /**
+         * Returns the parameter at the path or nullptr if it does not exist. Does not copy the parameter.
+         * Parameters of the parameter schema are looked up in the index that is built by resolve_parameters().
+         * @param t_path
+         * @return
+         */
+        const nlohmann::json *find_parameter_value(const std::vector<std::string> &t_path) const;
+
+        misa_filesystem &get_filesystem() {
+            if(!static_cast<bool>(m_root))
+                throw std::runtime_error("No root module set!");
+            return m_root->get_or_create_instance()->get_module()->filesystem;
+        }
+        
+    private:
+
+        size_t m_known_nodes_count = 0;
+
+        size_t m_finished_nodes_count = 0;
+
+        size_t m_last_waiting_announcement = 0;
+
+        size_t m_last_rejecting_announcement = 0;
+
+        /**
+         * Minimum time between two reports of finished nodes
+         */
+        static constexpr std::chrono::milliseconds progress_interval { 100 };
+
+        std::chrono::steady_clock::time_point m_last_progress_time;
+
+        bool m_tree_complete = false;
+
+        /**
+         * Number of known dispatchers that did not build their subtree, yet
+         */
+        size_t m_incomplete_subtrees = 0;
+
+        /**
+         * Dispatchers that worked, but can still add children to their subtree
+         */
+        std::unordered_set<misa_work_node *> m_incomplete_builds;
+
+        /**
+         * Parameter schema of this run. Built before the actual work is scheduled.
+         */
+        nlohmann::json m_parameter_schema;
+
+        /**
+         * Parameters of the parameter schema by their key (e.g. /algorithm/threshold)
+         * Points into m_parameters.
+         */
+        std::unordered_map<std::string, const nlohmann::json *> m_parameter_index;
+
+        /**
+         * Samples that finished and can release their subtree and caches.
+         * Only used if samples are streamed (see m_max_samples_in_flight)
+         */
+        std::vector<misa_work_node *> m_finished_samples;
+
+        /**
+         * Number of post-processing jobs of finished samples that are still running
+         */
+        size_t m_sample_postprocessing_jobs = 0;
+
+        std::mutex m_sample_postprocessing_mutex;
+
+        std::condition_variable m_sample_postprocessing_condition;
+
+        /**
+         * First exception thrown by a post-processing job of a finished sample
+         */
+        std::exception_ptr m_sample_postprocessing_exception;
+
+        /**
+         * Finished samples whose post-processing jobs are done.
+         * Their exported filesystem entries are removed by the dispatcher, as the jobs still resolve paths in the filesystem.
+         */
+        std::vector<std::string> m_postprocessed_samples;
+
+        /**
+         * Number of nodes that wait for their dependencies
+         */
+        size_t m_nodes_waiting_for_dependencies = 0;
+
+        /**
+         * Number of nodes that are currently working in another thread
+         */
+        size_t m_nodes_running = 0;
+
+        /**
+         * Number of threads that are currently inside the work() function of a node.
+         * Unlike m_nodes_running, this excludes nodes that are queued in the pool.
+         */
+        std::atomic<int> m_threads_working { 0 };
+
+        /**
+         * Node that finished work() in a worker thread
+         */
+        struct worked_node {
+            misa_work_node *node;
+            /**
+             * Runtime of work() in ms
+             */
+            double runtime;
+            /**
+             * Worker thread that ran the node
+             */
+            int thread;
+        };
+
+        /**
+         * Worker thread that ran each finished node.
+         * Only recorded if the workers are spread over multiple NUMA nodes.
+         */
+        std::unordered_map<const misa_work_node *, int> m_node_threads;
+
+        /**
+         * Worker thread that ran the dependency of a ready task that wrote into the inputs of the task.
+         * The task is submitted into the queue of this thread.
+         */
+        std::unordered_map<const misa_work_node *, int> m_producer_threads;
+
+        /**
+         * Worker thread that ran the node that is currently processed by the dispatcher (-1 if unknown)
+         */
+        int m_worked_thread = -1;
+
+        /**
+         * Returns the worker thread that wrote the inputs of the node or a worker thread on the NUMA node that ran
+         * the dependencies of the node (-1 if there is none)
+         * @param t_node
+         * @return
+         */
+        int get_preferred_thread(const misa_work_node *t_node) const;
+
+        /**
+         * Nodes that finished work() in a worker thread and were not processed by the dispatcher, yet
+         */
+        std::vector<worked_node> m_nodes_worked;
+
+        std::mutex m_nodes_worked_mutex;
+
+        /**
+         * True if the dispatcher is queued or running in the thread pool
+         */
+        std::atomic<bool> m_dispatcher_scheduled { false };
+
+        bool m_dispatcher_finished = false;
+
+        std::exception_ptr m_dispatcher_exception;
+
+        std::condition_variable m_dispatcher_finished_condition;
+
+        /**
+         * Prepared nodes that cannot start, as their memory estimate does not fit into the budget
+         */
+        std::deque<misa_work_node *> m_nodes_waiting_for_memory;
+
+        /**
+         * Memory estimates of the nodes that are currently working
+         */
+        std::unordered_map<misa_work_node *, size_t> m_memory_reserved;
+
+        /**
+         * Sum of the reserved memory estimates
+         */
+        size_t m_memory_in_use = 0;
+
+        /**
+         * Number of nodes that had to wait for memory
+         */
+        size_t m_memory_waits_count = 0;
+
+        /**
+         * Number of slots of each resource class that are held by nodes
+         */
+        std::array<size_t, 2> m_resource_slots_in_use {{ 0, 0 }};
+
+        /**
+         * Resource class of the nodes that hold a slot
+         */
+        std::unordered_map<misa_work_node *, misa_resource_class> m_slot_holders;
+
+        /**
+         * Prepared nodes that wait for a free slot of their resource class
+         */
+        std::array<std::deque<misa_work_node *>, 2> m_nodes_waiting_for_slot;
+
+        /**
+         * Number of nodes that had to wait for a slot
+         */
+        size_t m_slot_waits_count = 0;
+
+        /**
+         * Sum and count of the measured runtimes (in ms) of tasks with the same algorithm path
+         */
+        std::unordered_map<std::string, std::pair<double, size_t>> m_measured_costs;
+
+        /**
+         * Tasks without estimated runtime that are working to measure the runtime of their algorithm path
+         */
+        std::unordered_map<misa_work_node *, std::string> m_measuring_nodes;
+
+        /**
+         * Number of measuring tasks and the tasks that wait for a measurement (for each algorithm path)
+         */
+        std::unordered_map<std::string, std::pair<size_t, std::vector<misa_work_node *>>> m_nodes_waiting_for_measurement;
+
+        /**
+         * Number of batches that contained more than one task
+         */
+        size_t m_batches_count = 0;
+
+        /**
+         * Number of tasks that were run in batches
+         */
+        size_t m_batched_nodes_count = 0;
+
+        /**
+         * Fused successor of each submitted task that was not processed by the dispatcher, yet
+         */
+        std::unordered_map<misa_work_node *, misa_work_node *> m_fused_successors;
+
+        /**
+         * Tasks that were submitted together with their only dependency.
+         * They are not put into the ready queue when the dependency finishes.
+         */
+        std::unordered_set<misa_work_node *> m_fused_nodes;
+
+        /**
+         * Number of tasks that were run together with their only dependency
+         */
+        size_t m_fused_nodes_count = 0;
+
+        /**
+         * Thread pool that runs the dispatcher and the parallelized workers
+         */
+        std::unique_ptr<misaxx::utils::work_stealing_pool> m_pool;
+
+        void run_single_threaded();
+
+        void run_parallel();
+
+        /**
+         * Creates the thread pool. Exceptions that escape from its jobs stop the dispatcher.
+         */
+        void create_pool();
+
+        /**
+         * Submits the dispatcher into the thread pool if it is not already scheduled
+         */
+        void schedule_dispatcher();
+
+        /**
+         * Processes finished nodes and starts ready nodes.
+         * Runs as job inside the thread pool. Only one dispatcher job is active at the same time.
+         */
+        void dispatch();
+
+        /**
+         * Stops the dispatcher and wakes up the thread that waits in run_parallel()
+         * @param t_exception
+         */
+        void finish_dispatcher(std::exception_ptr t_exception);
+
+        /**
+         * Runs a prepared node in the dispatcher thread or submits it into the pool
+         * @param t_node
+         */
+        void start_work(misa_work_node *t_node);
+
+        /**
+         * Name of the trace span of a worker. Only built if tracing is enabled.
+         * @param t_node
+         * @return
+         */
+        static std::string get_trace_name(const misa_work_node &t_node);
+
+        /**
+         * Submits prepared parallelizeable nodes into the pool. The nodes are worked one after another by the same job.
+         * @param t_batch
+         */
+        void start_batch(std::vector<misa_work_node *> t_batch);
+
+        /**
+         * Removes ready siblings of a small task from the ready queue that can be run in the same job.
+         * The batch is sized by the batch duration and the estimated runtime of the task.
+         * @param t_node Prepared task
+         * @return The task and the prepared siblings
+         */
+        std::vector<misa_work_node *> collect_batch(misa_work_node *t_node);
+
+        /**
+         * Returns the only dependent task of a task if it can run in the same job directly after the task.
+         * The dependent must only depend on the task, be parallelizeable and have no memory estimate.
+         * A barrier that only waits for the task is returned as well, so its dependent can be fused next.
+         * The returned task is prepared.
+         * @param t_node Prepared task or barrier
+         * @return The prepared dependent or nullptr
+         */
+        misa_work_node *get_fusable_successor(misa_work_node *t_node);
+
+        /**
+         * Returns true if the node is a barrier that waits for a single dependency.
+         * Such a barrier does not delay its dependents and can be worked in the job of its dependency.
+         * @param t_node
+         * @return
+         */
+        static bool is_transparent_barrier(const misa_work_node *t_node);
+
+        /**
+         * Removes the fused successors of a task that rejected its work.
+         * The successors were skipped by the job and are put into the ready queue when the task finishes.
+         * @param t_node
+         */
+        void unfuse_successors(misa_work_node *t_node);
+
+        /**
+         * Holds back a ready task without estimated runtime if enough tasks with the same algorithm path are already
+         * working to measure the runtime. This allows batching of the held back tasks.
+         * @param t_node
+         * @return true if the task waits for the measurement
+         */
+        bool wait_for_measurement(misa_work_node *t_node);
+
+        /**
+         * Moves the tasks that wait for the measurement of a finished task back into the ready queue
+         * @param t_node
+         */
+        void finish_measurement(misa_work_node *t_node);
+
+        /**
+         * Returns the estimated runtime (in ms) of a task or the average runtime of finished tasks with the same algorithm path
+         * @param t_node
+         * @return
+         */
+        double get_batch_cost(misa_work_node *t_node) const;
+
+        /**
+         * Starts the nodes that wait for memory until the first one does not fit into the budget
+         */
+        void start_waiting_for_memory();
+
+        /**
+         * Returns the memory estimate of a prepared node or 0 if the memory is not limited
+         * @param t_node
+         * @return
+         */
+        size_t get_memory_estimate(misa_work_node *t_node) const;
+
+        /**
+         * Reserves the memory estimate of a prepared node
+         * @param t_node
+         * @param t_estimate
+         * @return false if the estimate does not fit into the remaining memory budget
+         */
+        bool try_reserve_memory(misa_work_node *t_node, size_t t_estimate);
+
+        /**
+         * Releases the memory that was reserved for the node
+         * @param t_node
+         */
+        void release_memory(misa_work_node *t_node);
+
+        /**
+         * Returns the resource class of a prepared node. Nodes that are not tasks are compute-bound.
+         * @param t_node
+         * @return
+         */
+        misa_resource_class get_resource_class(misa_work_node *t_node) const;
+
+        /**
+         * Takes a slot of the resource class of a prepared node
+         * @param t_node
+         * @return false if all slots of the resource class are taken
+         */
+        bool try_acquire_slot(misa_work_node *t_node);
+
+        /**
+         * Releases the slot that was taken by the node and moves the next node that waits for the slot back into the ready queue
+         * @param t_node
+         */
+        void release_slot(misa_work_node *t_node);
+
+        /**
+         * Makes a node known to the runtime.
+         * The node registers itself as dependent of the unfinished dependencies.
+         * @param t_node
+         * @return true if all dependencies are finished and the node should be put into the ready queue
+         */
+        bool enqueue(misa_work_node *t_node);
+
+        /**
+         * Updates the scheduler after the work() function of a node returned
+         * @param t_node
+         */
+        void process_worked(misa_work_node *t_node);
+
+        /**
+         * Marks a node as finished and notifies its dependents and its parent
+         * @param t_node
+         */
+        void finish(misa_work_node *t_node);
+
+        /**
+         * Returns true if samples are built lazily and released after they finished
+         * @return
+         */
+        bool is_streaming_samples() const {
+            return !m_is_simulating && (m_max_samples_in_flight > 0 || !m_work_queue_path.empty());
+        }
+
+        /**
+         * Assigns the caches that were registered since the last call to their sample.
+         * Caches of a sample are located in imported/<sample> or exported/<sample>.
+         * Each cache is only looked at once.
+         */
+        void sort_sample_caches();
+
+        /**
+         * Post-processes the caches of the finished samples, exports their attachments and unregisters them.
+         * Releases the subtrees of the samples.
+         * Must not be called while finish() is running.
+         */
+        void release_finished_samples();
+
+        /**
+         * Removes the exported filesystem entries of finished samples whose post-processing jobs are done.
+         * Must not be called while finish() is running.
+         */
+        void remove_postprocessed_samples();
+
+        /**
+         * Waits until the post-processing jobs of finished samples are done and rethrows their first exception
+         */
+        void wait_for_sample_postprocessing();
+
+        /**
+         * Enqueues the children of a dispatcher that are not done
+         * @param t_node The dispatcher
+         * @param t_first Index of the first child that is checked
+         * @return Number of enqueued children
+         */
+        size_t enqueue_children(misa_work_node *t_node, size_t t_first);
+
+        /**
+         * Lets a dispatcher with an incomplete build add more children and enqueues them
+         * @param t_node The dispatcher
+         * @return Number of enqueued children
+         */
+        size_t build_incremental(misa_work_node *t_node);
+
+        /**
+         * Marks that a dispatcher completed its subtree
+         */
+        void complete_subtree();
+
+        /**
+         * Moves all rejected nodes back into the ready queue
+         */
+        void retry_rejected();
+
+        /**
+         * Puts a node into the ready queue
+         * @param t_node
+         * @param t_producer Dependency that just finished and made the node ready (or nullptr)
+         */
+        void push_ready(misa_work_node *t_node, misa_work_node *t_producer = nullptr);
+
+        /**
+         * Returns how much input data of a ready task is expected to be in memory.
+         * Each input cache that holds data counts once. Inputs that were just written by the producer count twice.
+         * Prepares the task if necessary, as the inputs are declared in prepare_work().
+         * @param t_node
+         * @param t_is_produced Set to true if the producer wrote into an input
+         * @return
+         */
+        size_t get_locality(const ready_node &t_node, bool &t_is_produced);
+
+        /**
+         * Removes a node with the highest rank from the ready queue.
+         * Among the first locality_candidates nodes with this rank, the task with the most input data in memory is chosen.
+         * Only these candidates are prepared. Nothing is prepared as long as no task declared input caches.
+         * @return
+         */
+        misa_work_node *pop_ready();
+
+        /**
+         * Returns the estimated runtime (in ms) of a node.
+         * The cost hint of a task has priority over the runtime history.
+         * Dispatchers are estimated by the runtime of their whole subtree.
+         * @param t_node
+         * @return
+         */
+        double get_cost(misa_work_node *t_node) const;
+
+        /**
+         * Returns the estimated runtime of the longest path from the node through its known dependents
+         * @param t_node
+         * @return
+         */
+        double get_rank(misa_work_node *t_node);
+
+        /**
+         * Removes the cached rank of a node that got a new dependent and of all nodes whose rank depends on it.
+         * Nodes that are already in the ready queue keep their rank.
+         * @param t_node
+         */
+        void invalidate_rank(misa_work_node *t_node);
+
+        /**
+         * Announces the number of waiting and rejecting workers if they changed
+         */
+        void announce_blocked_workers();
+
+        /**
+         * Writes a line of the progress protocol (<percentage> <finished / known> text) into the log
+         * @param t_text
+         * @param t_level
+         */
+        void progress(const std::string &t_text, misaxx::utils::log_level t_level = misaxx::utils::log_level::info);
+
+        void progress(const misa_work_node &t_node, const std::string &t_text, misaxx::utils::log_level t_level = misaxx::utils::log_level::info);
+
+        /**
+         * Returns true if the progress of finished nodes should be reported.
+         * Limits the progress to one line per progress_interval unless the log level is debug.
+         * @return
+         */
+        bool is_progress_due();
+
+        /**
+         * Writes a JSON file into the output directory.
+         * If the runtime is sharded, the file is shared with other processes and the content is merged into
+         * the existing file.
+         * @param t_path
+         * @param t_json
+         */
+        void write_output_json(const boost::filesystem::path &t_path, nlohmann::json t_json);
+
+        /**
+         * Runs independent post-processing jobs.
+         * If the runtime is multi-threaded, the jobs are distributed over the worker threads.
+         * The calling thread waits until all jobs are finished. The first exception is rethrown.
+         * @param t_num_jobs
+         * @param t_job Receives the index of the job and the index of the thread that runs it
+         */
+        void run_postprocessing_jobs(size_t t_num_jobs, const std::function<void(size_t, int)> &t_job);
+
+        /**
+         * Runs a function for each registered cache. See run_postprocessing_jobs()
+         * @param t_function Receives the cache and the index of the thread that processes it
+         */
+        void for_each_registered_cache(const std::function<void(const std::shared_ptr<misa_cache> &, int)> &t_function);
+
+        /**
+         * Writes the attachments of a cache as members of the current object of the writer
+         * @param t_cache
+         * @param t_attachments
+         * @param t_writer
+         * @param t_add_schema Called for each serialized object
+         */
+        void write_cache_attachments(const std::shared_ptr<misa_cache> &t_cache,
+                                     const misa_cached_data_base::attachment_type &t_attachments,
+                                     misaxx::utils::json_object_writer &t_writer,
+                                     const std::function<void(const misa_serializable &)> &t_add_schema);
+
+        void postprocess_caches();
+
+        /**
+         * Post-processes a single cache
+         * @param t_cache
+         * @param t_thread Thread that runs the post-processing
+         */
+        void postprocess_cache(const std::shared_ptr<misa_cache> &t_cache, int t_thread);
+
+        /**
+         * Adds the JSON schema of an exported object to the attachment schemas. Thread-safe.
+         * @param t_serializable
+         */
+        void add_attachment_schema(const misa_serializable &t_serializable);
+
+        /**
+         * Groups caches by the attachment store they are written into (e.g. exported/<sample>)
+         * Only used if the attachment storage is "sample"
+         * @param t_caches
+         * @return
+         */
+        std::map<boost::filesystem::path, std::vector<std::shared_ptr<misa_cache>>> get_attachment_stores(const std::vector<std::shared_ptr<misa_cache>> &t_caches) const;
+
+        /**
+         * Writes the attachments of caches into the attachment store of their group
+         * @param t_group
+         * @param t_caches
+         * @param t_thread Thread that writes the store
+         */
+        void write_attachment_store(const boost::filesystem::path &t_group, const std::vector<std::shared_ptr<misa_cache>> &t_caches, int t_thread);
+
+        /**
+         * Writes the attachments of a cache into their own file
+         * @param t_cache
+         * @param t_thread Thread that writes the file
+         */
+        void write_attachment_file(const std::shared_ptr<misa_cache> &t_cache, int t_thread);
+
+        /**
+         * Exports the attachments of caches, which belong to a finished sample
+         * @param t_caches
+         * @param t_thread
+         */
+        void export_cache_attachments(const std::vector<std::shared_ptr<misa_cache>> &t_caches, int t_thread);
+
+        void postprocess_cache_attachments();
+
+        void postprocess_parameter_schema();
+
+        /**
+         * Simulates the schema workload and stores the parameter schema in m_parameter_schema.
+         * The schema root works on an empty filesystem, so the actual workload is not affected.
+         * Uses the parameter schema cache if possible.
+         */
+        void build_parameter_schema();
+
+        /**
+         * Looks up all parameters of the parameter schema and indexes them.
+         * Throws an exception that lists all required parameters that do not exist.
+         */
+        void resolve_parameters();
+
+        /**
+         * Clears the state of the scheduler
+         */
+        void reset_scheduler();
+
+        /**
+         * Returns a key that identifies the parameter schema of this run.
+         * It depends on the module info, the parameter structure and the samples.
+         * @return
+         */
+        std::string get_parameter_schema_key();
+    };
+}
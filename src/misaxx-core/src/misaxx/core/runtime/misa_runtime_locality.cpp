@@ -0,0 +1,102 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#include <algorithm>
+#include "misa_runtime_impl.h"
+
+namespace misaxx {
+    void misa_runtime_impl::push_ready(misa_work_node *t_node, misa_work_node *t_producer) {
+        m_nodes_ready.push(ready_node { get_rank(t_node), m_nodes_ready_sequence++, t_node, t_producer, m_worked_thread });
+    }
+
+    size_t misa_runtime_impl::get_locality(const ready_node &t_node, bool &t_is_produced) {
+        t_is_produced = false;
+        const auto task = std::dynamic_pointer_cast<misa_task>(t_node.node->get_or_create_instance());
+        if (!static_cast<bool>(task))
+            return 0;
+        if (t_node.node->get_worker_status() == misa_worker_status::undone) {
+            t_node.node->prepare_work();
+        }
+
+        const misa_cache_usage *produced = nullptr;
+        if (t_node.producer != nullptr) {
+            if (const auto producer = std::dynamic_pointer_cast<misa_task>(t_node.producer->get_instance())) {
+                produced = &producer->get_cache_usage();
+            }
+        }
+        size_t locality = 0;
+        for (const auto &cache : task->get_cache_usage().inputs) {
+            if (produced != nullptr && std::find(produced->outputs.begin(), produced->outputs.end(), cache) != produced->outputs.end()) {
+                locality += 2;
+                t_is_produced = true;
+            } else if (cache->has_data()) {
+                ++locality;
+            }
+        }
+        return locality;
+    }
+
+    misa_work_node *misa_runtime_impl::pop_ready() {
+        if (!m_cache_inputs_declared) {
+            misa_work_node *nd = m_nodes_ready.top().node;
+            m_nodes_ready.pop();
+            return nd;
+        }
+
+        // Only the first nodes with the highest rank are prepared to compare their locality
+        std::vector<ready_node> candidates { m_nodes_ready.top() };
+        m_nodes_ready.pop();
+        while (!m_nodes_ready.empty() && candidates.size() < locality_candidates && m_nodes_ready.top().rank == candidates.front().rank) {
+            candidates.push_back(m_nodes_ready.top());
+            m_nodes_ready.pop();
+        }
+
+        size_t best = 0;
+        size_t best_locality = 0;
+        bool best_is_produced = false;
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            bool is_produced = false;
+            const size_t locality = get_locality(candidates[i], is_produced);
+            if (i == 0 || locality > best_locality) {
+                best = i;
+                best_locality = locality;
+                best_is_produced = is_produced;
+            }
+        }
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            if (i != best)
+                m_nodes_ready.push(candidates[i]);
+        }
+
+        const ready_node &nd = candidates[best];
+        if (best_is_produced && nd.producer_thread >= 0) {
+            m_producer_threads[nd.node] = nd.producer_thread;
+        }
+        return nd.node;
+    }
+
+    int misa_runtime_impl::get_preferred_thread(const misa_work_node *t_node) const {
+        // The inputs that were just written by a dependency are still in the caches of its thread
+        auto producer = m_producer_threads.find(t_node);
+        if (producer != m_producer_threads.end())
+            return producer->second;
+        if (m_node_threads.empty())
+            return -1;
+        // Data that was decoded by a dependency is in the memory of its NUMA node
+        for (const auto &dependency : t_node->get_dependencies()) {
+            auto it = m_node_threads.find(dependency.get());
+            if (it != m_node_threads.end())
+                return it->second;
+        }
+        return -1;
+    }
+}
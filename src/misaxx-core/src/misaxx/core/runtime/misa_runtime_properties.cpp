@@ -20,6 +20,10 @@ int misaxx::runtime_properties::get_num_threads() {
     return misa_runtime::instance().get_num_threads();
 }
 
+int misaxx::runtime_properties::get_thread_budget() {
+    return misa_runtime::instance().get_thread_budget();
+}
+
 bool misaxx::runtime_properties::is_simulating() {
     return misa_runtime::instance().is_simulating();
 }
@@ -43,3 +47,27 @@ misa_filesystem misaxx::runtime_properties::get_root_filesystem() {
 misa_module_info runtime_properties::get_module_info() {
     return misa_runtime::instance().get_module_info();
 }
+
+int runtime_properties::get_shard_index() {
+    return misa_runtime::instance().get_shard_index();
+}
+
+int runtime_properties::get_shard_count() {
+    return misa_runtime::instance().get_shard_count();
+}
+
+boost::filesystem::path runtime_properties::get_work_queue_path() {
+    return misa_runtime::instance().get_work_queue_path();
+}
+
+size_t runtime_properties::get_max_samples_in_flight() {
+    return misa_runtime::instance().get_max_samples_in_flight();
+}
+
+std::string runtime_properties::get_shard_id() {
+    return misa_runtime::instance().get_shard_id();
+}
+
+boost::filesystem::path runtime_properties::get_memoization_store_path() {
+    return misa_runtime::instance().get_memoization_store_path();
+}
@@ -0,0 +1,89 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#include "misa_runtime_impl.h"
+
+namespace misaxx {
+    void misa_runtime_impl::start_waiting_for_memory() {
+        while (!m_nodes_waiting_for_memory.empty()) {
+            auto *nd = m_nodes_waiting_for_memory.front();
+            if (!try_reserve_memory(nd, get_memory_estimate(nd)))
+                return;
+            m_nodes_waiting_for_memory.pop_front();
+            progress(*nd, "Memory available. Starting work on", misaxx::utils::log_level::debug);
+            start_work(nd);
+        }
+    }
+
+    size_t misa_runtime_impl::get_memory_estimate(misa_work_node *t_node) const {
+        if (m_memory_budget == 0)
+            return 0;
+        const auto task = std::dynamic_pointer_cast<misa_task>(t_node->get_instance());
+        if (!static_cast<bool>(task))
+            return 0;
+        return task->get_memory_estimate();
+    }
+
+    bool misa_runtime_impl::try_reserve_memory(misa_work_node *t_node, size_t t_estimate) {
+        if (t_estimate == 0)
+            return true;
+
+        // A task that exceeds the budget on its own can only run if nothing else holds memory
+        if (m_memory_in_use > 0 && m_memory_in_use + t_estimate > m_memory_budget)
+            return false;
+
+        m_memory_in_use += t_estimate;
+        m_memory_reserved[t_node] = t_estimate;
+        return true;
+    }
+
+    void misa_runtime_impl::release_memory(misa_work_node *t_node) {
+        auto it = m_memory_reserved.find(t_node);
+        if (it != m_memory_reserved.end()) {
+            m_memory_in_use -= it->second;
+            m_memory_reserved.erase(it);
+        }
+    }
+
+    misa_resource_class misa_runtime_impl::get_resource_class(misa_work_node *t_node) const {
+        const auto task = std::dynamic_pointer_cast<misa_task>(t_node->get_instance());
+        if (!static_cast<bool>(task))
+            return misa_resource_class::compute;
+        return task->get_resource_class();
+    }
+
+    bool misa_runtime_impl::try_acquire_slot(misa_work_node *t_node) {
+        const misa_resource_class resource_class = get_resource_class(t_node);
+        const auto index = static_cast<size_t>(resource_class);
+        if (m_resource_slots[index] == 0)
+            return true;
+        if (m_resource_slots_in_use[index] >= m_resource_slots[index])
+            return false;
+        ++m_resource_slots_in_use[index];
+        m_slot_holders[t_node] = resource_class;
+        return true;
+    }
+
+    void misa_runtime_impl::release_slot(misa_work_node *t_node) {
+        auto it = m_slot_holders.find(t_node);
+        if (it == m_slot_holders.end())
+            return;
+        const auto index = static_cast<size_t>(it->second);
+        --m_resource_slots_in_use[index];
+        m_slot_holders.erase(it);
+        auto &waiting = m_nodes_waiting_for_slot[index];
+        if (!waiting.empty()) {
+            push_ready(waiting.front());
+            waiting.pop_front();
+        }
+    }
+}
@@ -0,0 +1,132 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "misa_sha256.h"
+
+using namespace misaxx;
+
+namespace {
+    constexpr std::array<uint32_t, 64> round_constants {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+    };
+
+    inline uint32_t rotate_right(uint32_t t_value, int t_bits) {
+        return (t_value >> t_bits) | (t_value << (32 - t_bits));
+    }
+}
+
+misa_sha256::misa_sha256() : m_state { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                       0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 } {
+
+}
+
+void misa_sha256::update(const char *t_data, size_t t_size) {
+    for(size_t i = 0; i < t_size; ++i) {
+        m_block[m_block_size++] = static_cast<unsigned char>(t_data[i]);
+        if(m_block_size == m_block.size()) {
+            process_block();
+            m_block_size = 0;
+        }
+    }
+    m_length += t_size;
+}
+
+void misa_sha256::update(const std::string &t_value) {
+    const std::string size = std::to_string(t_value.size()) + ":";
+    update(size.data(), size.size());
+    update(t_value.data(), t_value.size());
+}
+
+void misa_sha256::update_file(const boost::filesystem::path &t_path) {
+    std::ifstream in { t_path.string(), std::ios::binary };
+    if(!in)
+        throw std::runtime_error("Cannot read " + t_path.string());
+    std::vector<char> buffer(1 << 16);
+    while(in) {
+        in.read(buffer.data(), buffer.size());
+        update(buffer.data(), static_cast<size_t>(in.gcount()));
+    }
+}
+
+std::string misa_sha256::to_string() {
+    // Padding: a single 1 bit, zeros and the message length in bits
+    const uint64_t length_bits = m_length * 8;
+    const char one = static_cast<char>(0x80);
+    const char zero = 0;
+    update(&one, 1);
+    while(m_block_size != 56) {
+        update(&zero, 1);
+    }
+    for(int i = 7; i >= 0; --i) {
+        const auto byte = static_cast<char>((length_bits >> (i * 8)) & 0xff);
+        update(&byte, 1);
+    }
+
+    std::stringstream stream;
+    stream << std::hex << std::setfill('0');
+    for(uint32_t word : m_state) {
+        stream << std::setw(8) << word;
+    }
+    return stream.str();
+}
+
+void misa_sha256::process_block() {
+    std::array<uint32_t, 64> w {};
+    for(size_t i = 0; i < 16; ++i) {
+        w[i] = (static_cast<uint32_t>(m_block[i * 4]) << 24) | (static_cast<uint32_t>(m_block[i * 4 + 1]) << 16) |
+               (static_cast<uint32_t>(m_block[i * 4 + 2]) << 8) | static_cast<uint32_t>(m_block[i * 4 + 3]);
+    }
+    for(size_t i = 16; i < 64; ++i) {
+        const uint32_t s0 = rotate_right(w[i - 15], 7) ^ rotate_right(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        const uint32_t s1 = rotate_right(w[i - 2], 17) ^ rotate_right(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = m_state[0], b = m_state[1], c = m_state[2], d = m_state[3];
+    uint32_t e = m_state[4], f = m_state[5], g = m_state[6], h = m_state[7];
+    for(size_t i = 0; i < 64; ++i) {
+        const uint32_t s1 = rotate_right(e, 6) ^ rotate_right(e, 11) ^ rotate_right(e, 25);
+        const uint32_t ch = (e & f) ^ (~e & g);
+        const uint32_t t1 = h + s1 + ch + round_constants[i] + w[i];
+        const uint32_t s0 = rotate_right(a, 2) ^ rotate_right(a, 13) ^ rotate_right(a, 22);
+        const uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+        const uint32_t t2 = s0 + maj;
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    m_state[0] += a;
+    m_state[1] += b;
+    m_state[2] += c;
+    m_state[3] += d;
+    m_state[4] += e;
+    m_state[5] += f;
+    m_state[6] += g;
+    m_state[7] += h;
+}
@@ -0,0 +1,59 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <boost/filesystem/path.hpp>
+
+namespace misaxx {
+
+    /**
+     * SHA-256 hash (FIPS 180-4)
+     */
+    class misa_sha256 {
+    public:
+
+        misa_sha256();
+
+        void update(const char *t_data, size_t t_size);
+
+        /**
+         * Hashes a value together with its size, so consecutive values are separated
+         * @param t_value
+         */
+        void update(const std::string &t_value);
+
+        /**
+         * Hashes the content of a file
+         * @param t_path
+         */
+        void update_file(const boost::filesystem::path &t_path);
+
+        /**
+         * Finishes the hash and returns the digest as hexadecimal string.
+         * The hash cannot be updated afterwards.
+         * @return
+         */
+        std::string to_string();
+
+    private:
+        std::array<uint32_t, 8> m_state;
+        std::array<unsigned char, 64> m_block;
+        size_t m_block_size = 0;
+        uint64_t m_length = 0;
+
+        void process_block();
+    };
+}
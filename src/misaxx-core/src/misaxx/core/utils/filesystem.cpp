@@ -14,6 +14,9 @@
 #include <misaxx/core/utils/filesystem.h>
 #include <boost/regex.hpp>
 #include <boost/algorithm/string.hpp>
+#include <cstdio>
+#include <ctime>
+#include <thread>
 
 boost::filesystem::path
 misaxx::utils::relativize_to_direct_parent(boost::filesystem::path t_parent, boost::filesystem::path t_path) {
@@ -60,3 +63,34 @@ boost::filesystem::path misaxx::utils::make_preferred(boost::filesystem::path pa
     return path;
 #endif
 }
+
+bool misaxx::utils::try_create_lock_file(const boost::filesystem::path &t_path, const std::string &t_owner) {
+    // Exclusive creation ("x") fails if the file already exists
+    std::FILE *file = std::fopen(t_path.string().c_str(), "wx");
+    if(file == nullptr) {
+        if(!boost::filesystem::exists(t_path))
+            throw std::runtime_error("Unable to create lock file " + t_path.string());
+        return false;
+    }
+    std::fputs(t_owner.c_str(), file);
+    std::fclose(file);
+    return true;
+}
+
+misaxx::utils::scoped_lock_file::scoped_lock_file(boost::filesystem::path t_path, const std::string &t_owner,
+                                                  int t_stale_timeout_seconds) : m_path(std::move(t_path)) {
+    while(!try_create_lock_file(m_path, t_owner)) {
+        boost::system::error_code ec;
+        const std::time_t modified = boost::filesystem::last_write_time(m_path, ec);
+        if(!ec && std::time(nullptr) - modified > t_stale_timeout_seconds) {
+            boost::filesystem::remove(m_path, ec);
+            continue;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+}
+
+misaxx::utils::scoped_lock_file::~scoped_lock_file() {
+    boost::system::error_code ec;
+    boost::filesystem::remove(m_path, ec);
+}
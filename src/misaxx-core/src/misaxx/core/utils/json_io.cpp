@@ -0,0 +1,237 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#include <misaxx/core/utils/json_io.h>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/algorithm/string.hpp>
+#include <iomanip>
+#include <stdexcept>
+
+using namespace misaxx::utils;
+
+namespace {
+
+    /**
+     * Writes an unsigned integer in big-endian byte order
+     * @param t_stream
+     * @param t_value
+     * @param t_bytes
+     */
+    void write_big_endian(std::ostream &t_stream, uint64_t t_value, int t_bytes) {
+        for(int i = t_bytes - 1; i >= 0; --i) {
+            t_stream.put(static_cast<char>((t_value >> (8 * i)) & 0xFF));
+        }
+    }
+
+    /**
+     * Writes the header of a CBOR map (major type 5) with the given number of pairs
+     * @param t_stream
+     * @param t_size
+     */
+    void write_cbor_map_header(std::ostream &t_stream, uint64_t t_size) {
+        if(t_size <= 23) {
+            t_stream.put(static_cast<char>(0xA0 + t_size));
+        }
+        else if(t_size <= 0xFF) {
+            t_stream.put(static_cast<char>(0xB8));
+            write_big_endian(t_stream, t_size, 1);
+        }
+        else if(t_size <= 0xFFFF) {
+            t_stream.put(static_cast<char>(0xB9));
+            write_big_endian(t_stream, t_size, 2);
+        }
+        else if(t_size <= 0xFFFFFFFF) {
+            t_stream.put(static_cast<char>(0xBA));
+            write_big_endian(t_stream, t_size, 4);
+        }
+        else {
+            t_stream.put(static_cast<char>(0xBB));
+            write_big_endian(t_stream, t_size, 8);
+        }
+    }
+
+    /**
+     * Writes the header of a MessagePack map with the given number of pairs
+     * @param t_stream
+     * @param t_size
+     */
+    void write_msgpack_map_header(std::ostream &t_stream, uint64_t t_size) {
+        if(t_size <= 15) {
+            t_stream.put(static_cast<char>(0x80 | t_size));
+        }
+        else if(t_size <= 0xFFFF) {
+            t_stream.put(static_cast<char>(0xDE));
+            write_big_endian(t_stream, t_size, 2);
+        }
+        else if(t_size <= 0xFFFFFFFF) {
+            t_stream.put(static_cast<char>(0xDF));
+            write_big_endian(t_stream, t_size, 4);
+        }
+        else {
+            throw std::runtime_error("MessagePack maps cannot have more than 2^32 - 1 entries!");
+        }
+    }
+}
+
+json_format misaxx::utils::parse_json_format(const std::string &t_name) {
+    if(t_name == "json")
+        return json_format::json;
+    else if(t_name == "cbor")
+        return json_format::cbor;
+    else if(t_name == "msgpack")
+        return json_format::msgpack;
+    else
+        throw std::runtime_error("Unknown JSON format " + t_name + "! Supported are json, cbor and msgpack.");
+}
+
+std::string misaxx::utils::get_json_format_extension(json_format t_format) {
+    switch(t_format) {
+        case json_format::json:
+            return ".json";
+        case json_format::cbor:
+            return ".cbor";
+        case json_format::msgpack:
+            return ".msgpack";
+        default:
+            throw std::runtime_error("Unknown JSON format!");
+    }
+}
+
+bool misaxx::utils::is_json_file(const boost::filesystem::path &t_path) {
+    const std::string extension = boost::to_lower_copy(t_path.extension().string());
+    return extension == ".json" || extension == ".cbor" || extension == ".msgpack";
+}
+
+json_format misaxx::utils::get_json_format(const boost::filesystem::path &t_path) {
+    const std::string extension = boost::to_lower_copy(t_path.extension().string());
+    if(extension == ".cbor")
+        return json_format::cbor;
+    else if(extension == ".msgpack")
+        return json_format::msgpack;
+    else
+        return json_format::json;
+}
+
+nlohmann::json misaxx::utils::read_json(const boost::filesystem::path &t_path) {
+    const json_format format = get_json_format(t_path);
+    boost::filesystem::ifstream stream;
+    if(format == json_format::cbor) {
+        stream.open(t_path, std::ios::in | std::ios::binary);
+        return nlohmann::json::from_cbor(stream);
+    }
+    else if(format == json_format::msgpack) {
+        stream.open(t_path, std::ios::in | std::ios::binary);
+        return nlohmann::json::from_msgpack(stream);
+    }
+    else {
+        stream.open(t_path);
+        nlohmann::json result;
+        stream >> result;
+        return result;
+    }
+}
+
+void misaxx::utils::write_json(const boost::filesystem::path &t_path, const nlohmann::json &t_json, json_format t_format) {
+    boost::filesystem::ofstream stream;
+    if(t_format == json_format::cbor) {
+        stream.open(t_path, std::ios::out | std::ios::binary);
+        nlohmann::json::to_cbor(t_json, stream);
+    }
+    else if(t_format == json_format::msgpack) {
+        stream.open(t_path, std::ios::out | std::ios::binary);
+        nlohmann::json::to_msgpack(t_json, stream);
+    }
+    else {
+        stream.open(t_path);
+        stream << std::setw(4) << t_json;
+    }
+}
+
+json_object_writer::json_object_writer(std::ostream &t_stream, json_format t_format, size_t t_size) :
+    m_stream(t_stream), m_format(t_format) {
+    write_object_header(t_size);
+}
+
+void json_object_writer::write(const std::string &t_key, const nlohmann::json &t_value) {
+    write_key(t_key);
+    if(m_format == json_format::cbor) {
+        nlohmann::json::to_cbor(t_value, m_stream);
+    }
+    else if(m_format == json_format::msgpack) {
+        nlohmann::json::to_msgpack(t_value, m_stream);
+    }
+    else {
+        // Same layout as std::setw(4) on the whole object. Line breaks only occur between values.
+        std::string value = t_value.dump(4);
+        boost::replace_all(value, "\n", "\n" + std::string(4 * m_objects.size(), ' '));
+        m_stream << value;
+    }
+}
+
+void json_object_writer::begin_object(const std::string &t_key, size_t t_size) {
+    write_key(t_key);
+    write_object_header(t_size);
+}
+
+void json_object_writer::end_object() {
+    if(m_objects.size() <= 1)
+        throw std::runtime_error("There is no object that can be finished!");
+    write_object_end();
+}
+
+void json_object_writer::close() {
+    if(m_objects.size() != 1)
+        throw std::runtime_error("Attempted to close a JSON object with unfinished members!");
+    write_object_end();
+}
+
+void json_object_writer::write_object_header(size_t t_size) {
+    if(m_format == json_format::cbor)
+        write_cbor_map_header(m_stream, t_size);
+    else if(m_format == json_format::msgpack)
+        write_msgpack_map_header(m_stream, t_size);
+    else
+        m_stream << "{";
+    m_objects.emplace_back(object_state { t_size, 0 });
+}
+
+void json_object_writer::write_key(const std::string &t_key) {
+    if(m_objects.empty())
+        throw std::runtime_error("The JSON object is already closed!");
+    object_state &current = m_objects.back();
+    if(current.written >= current.size)
+        throw std::runtime_error("Attempted to write more members into the JSON object than announced!");
+    if(m_format == json_format::cbor) {
+        nlohmann::json::to_cbor(nlohmann::json(t_key), m_stream);
+    }
+    else if(m_format == json_format::msgpack) {
+        nlohmann::json::to_msgpack(nlohmann::json(t_key), m_stream);
+    }
+    else {
+        m_stream << (current.written > 0 ? ",\n" : "\n") << std::string(4 * m_objects.size(), ' ')
+                 << nlohmann::json(t_key).dump() << ": ";
+    }
+    ++current.written;
+}
+
+void json_object_writer::write_object_end() {
+    const object_state &current = m_objects.back();
+    if(current.written != current.size)
+        throw std::runtime_error("Attempted to write less members into the JSON object than announced!");
+    if(m_format == json_format::json) {
+        if(current.size > 0)
+            m_stream << "\n" << std::string(4 * (m_objects.size() - 1), ' ') << "}";
+        else
+            m_stream << "}";
+    }
+    m_objects.pop_back();
+}
@@ -0,0 +1,171 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#include <misaxx/core/utils/log.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+using namespace misaxx::utils;
+
+namespace {
+
+    /**
+     * Writes lines to stdout in a background thread.
+     * Producers push their lines into a lock-free list. The flusher takes the whole list at once.
+     */
+    class log_sink {
+    public:
+
+        /**
+         * Time between two flushes of the background thread
+         */
+        static constexpr std::chrono::milliseconds flush_interval { 50 };
+
+        std::atomic<log_level> level { log_level::info };
+
+        ~log_sink() {
+            if(m_flusher.joinable()) {
+                {
+                    std::lock_guard<std::mutex> lock(m_flusher_mutex);
+                    m_stop = true;
+                }
+                m_flusher_condition.notify_all();
+                m_flusher.join();
+            }
+            flush();
+        }
+
+        void push(std::string t_line) {
+            std::call_once(m_flusher_started, [this]() {
+                m_flusher = std::thread([this]() {
+                    run_flusher();
+                });
+            });
+            auto *entry = new log_entry { std::move(t_line), m_head.load(std::memory_order_relaxed) };
+            while(!m_head.compare_exchange_weak(entry->next, entry, std::memory_order_release, std::memory_order_relaxed)) {
+            }
+        }
+
+        void flush() {
+            std::lock_guard<std::mutex> lock(m_write_mutex);
+            log_entry *entry = m_head.exchange(nullptr, std::memory_order_acquire);
+            if(entry == nullptr)
+                return;
+
+            // The list contains the newest line first
+            log_entry *ordered = nullptr;
+            while(entry != nullptr) {
+                log_entry *next = entry->next;
+                entry->next = ordered;
+                ordered = entry;
+                entry = next;
+            }
+
+            std::string buffer;
+            while(ordered != nullptr) {
+                buffer += ordered->line;
+                buffer += '\n';
+                log_entry *next = ordered->next;
+                delete ordered;
+                ordered = next;
+            }
+            std::fwrite(buffer.data(), 1, buffer.size(), stdout);
+            std::fflush(stdout);
+        }
+
+    private:
+
+        struct log_entry {
+            std::string line;
+            log_entry *next;
+        };
+
+        std::atomic<log_entry*> m_head { nullptr };
+
+        std::once_flag m_flusher_started;
+
+        std::thread m_flusher;
+
+        bool m_stop = false;
+
+        std::mutex m_flusher_mutex;
+
+        std::condition_variable m_flusher_condition;
+
+        /**
+         * Keeps the order of lines if flush() is called by multiple threads
+         */
+        std::mutex m_write_mutex;
+
+        void run_flusher() {
+            std::unique_lock<std::mutex> lock(m_flusher_mutex);
+            while(!m_stop) {
+                m_flusher_condition.wait_for(lock, flush_interval);
+                flush();
+            }
+        }
+    };
+
+    log_sink &get_sink() {
+        static log_sink sink;
+        return sink;
+    }
+}
+
+void misaxx::utils::set_log_level(log_level t_level) {
+    get_sink().level = t_level;
+}
+
+log_level misaxx::utils::get_log_level() {
+    return get_sink().level;
+}
+
+bool misaxx::utils::is_logging(log_level t_level) {
+    return static_cast<int>(t_level) <= static_cast<int>(get_sink().level.load(std::memory_order_relaxed));
+}
+
+void misaxx::utils::log_line(std::string t_line) {
+    get_sink().push(std::move(t_line));
+}
+
+void misaxx::utils::flush_log() {
+    get_sink().flush();
+}
+
+log_message::log_message(log_level t_level) {
+    if(is_logging(t_level)) {
+        m_stream.emplace();
+    }
+}
+
+log_message::~log_message() {
+    if(m_stream) {
+        log_line(m_stream->str());
+    }
+}
+
+log_level misaxx::utils::log_level_from_string(const std::string &t_name) {
+    if(t_name == "error")
+        return log_level::error;
+    if(t_name == "warning")
+        return log_level::warning;
+    if(t_name == "info")
+        return log_level::info;
+    if(t_name == "debug")
+        return log_level::debug;
+    throw std::runtime_error("Unknown log level " + t_name);
+}
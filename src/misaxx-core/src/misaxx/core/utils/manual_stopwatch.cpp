@@ -11,6 +11,7 @@
  */
 
 #include <misaxx/core/utils/manual_stopwatch.h>
+#include <misaxx/core/utils/log.h>
 #include <stdexcept>
 #include <iostream>
 
@@ -50,14 +51,14 @@ void manual_stopwatch::new_operation(const std::string &t_operation, bool t_anno
         return;
 
     if(!m_operation.empty()) {
-        std::cout << "<< Finished sub-operation >> " << "[" << current_elapsed() << "ms" << "] " << m_operation << " <> " << m_name << "\n";
+        misaxx::utils::log_message(misaxx::utils::log_level::info) << "<< Finished sub-operation >> " << "[" << current_elapsed() << "ms" << "] " << m_operation << " <> " << m_name;
     }
 
     m_current_start = clock_t::now();
     m_operation = t_operation;
 
     if(t_announce) {
-        std::cout << "<< Started sub-operation >> " << m_operation << " <> " << m_name << "\n";
+        misaxx::utils::log_message(misaxx::utils::log_level::info) << "<< Started sub-operation >> " << m_operation << " <> " << m_name;
     }
 }
 
@@ -65,7 +66,7 @@ void manual_stopwatch::start() {
     if(!m_started) {
         m_current_start = clock_t::now();
         m_initial_start = clock_t::now();
-        std::cout << "<< Started >> " << m_name << "\n";
+        misaxx::utils::log_message(misaxx::utils::log_level::info) << "<< Started >> " << m_name;
 
         m_started = true;
     }
@@ -75,7 +76,7 @@ void manual_stopwatch::stop() {
     if(m_started) {
         m_stop = clock_t::now();
         m_started = false;
-        std::cout << "<< Finished >> " << "[" << elapsed() << "ms" << "] " << m_name << "\n";
+        misaxx::utils::log_message(misaxx::utils::log_level::info) << "<< Finished >> " << "[" << elapsed() << "ms" << "] " << m_name;
 
         m_durations.push_back(elapsed());
     }
@@ -0,0 +1,88 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#include <misaxx/core/utils/metrics.h>
+#include <boost/core/demangle.hpp>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <shared_mutex>
+#include <typeindex>
+#include <unordered_map>
+#include <nlohmann/json.hpp>
+
+using namespace misaxx::utils;
+
+namespace {
+
+    std::shared_mutex counters_mutex;
+
+    /**
+     * Counters by name. Nodes of std::map are stable, so references to the counters stay valid.
+     */
+    std::map<std::string, metric_counter> counters;
+
+    std::mutex cache_metrics_mutex;
+
+    std::unordered_map<std::type_index, std::unique_ptr<cache_metrics>> cache_metrics_by_type;
+}
+
+metric_counter &misaxx::utils::get_metric(const std::string &t_name) {
+    {
+        std::shared_lock<std::shared_mutex> lock(counters_mutex);
+        auto it = counters.find(t_name);
+        if(it != counters.end())
+            return it->second;
+    }
+    std::unique_lock<std::shared_mutex> lock(counters_mutex);
+    return counters[t_name];
+}
+
+const cache_metrics &misaxx::utils::get_cache_metrics(const std::type_info &t_type) {
+    std::lock_guard<std::mutex> lock(cache_metrics_mutex);
+    auto &entry = cache_metrics_by_type[std::type_index(t_type)];
+    if(!entry) {
+        const std::string prefix = "cache/" + boost::core::demangle(t_type.name()) + "/";
+        entry = std::make_unique<cache_metrics>(cache_metrics {
+                get_metric(prefix + "pulls"),
+                get_metric(prefix + "pushes"),
+                get_metric(prefix + "shared-lock-wait-ns"),
+                get_metric(prefix + "exclusive-lock-wait-ns")
+        });
+    }
+    return *entry;
+}
+
+std::map<std::string, uint64_t> misaxx::utils::get_metrics() {
+    std::map<std::string, uint64_t> result;
+    std::shared_lock<std::shared_mutex> lock(counters_mutex);
+    for(const auto &kv : counters) {
+        result[kv.first] = kv.second.get();
+    }
+    return result;
+}
+
+void misaxx::utils::reset_metrics() {
+    std::shared_lock<std::shared_mutex> lock(counters_mutex);
+    for(auto &kv : counters) {
+        kv.second.value = 0;
+    }
+}
+
+void misaxx::utils::write_metrics(const boost::filesystem::path &t_path) {
+    nlohmann::json j;
+    j["counters"] = get_metrics();
+    std::ofstream out;
+    out.open(t_path.string());
+    out << std::setw(4) << j;
+    out.close();
+}
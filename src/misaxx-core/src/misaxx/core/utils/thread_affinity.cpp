@@ -0,0 +1,188 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#include <misaxx/core/utils/thread_affinity.h>
+#include <boost/filesystem.hpp>
+#include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace misaxx::utils;
+
+namespace {
+
+    /**
+     * Parses a CPU list (e.g. "0,2,4-7") in the format used by Linux
+     * @param t_list
+     * @return
+     */
+    std::vector<int> parse_cpu_list(const std::string &t_list) {
+        std::vector<int> result;
+        std::vector<std::string> ranges;
+        boost::split(ranges, t_list, boost::is_any_of(","));
+        for(std::string range : ranges) {
+            boost::trim(range);
+            if(range.empty())
+                continue;
+            const auto separator = range.find('-');
+            try {
+                if(separator == std::string::npos) {
+                    result.push_back(std::stoi(range));
+                }
+                else {
+                    const int first = std::stoi(range.substr(0, separator));
+                    const int last = std::stoi(range.substr(separator + 1));
+                    for(int cpu = first; cpu <= last; ++cpu) {
+                        result.push_back(cpu);
+                    }
+                }
+            }
+            catch(const std::logic_error &) {
+                throw std::runtime_error("Invalid CPU list " + t_list);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * CPUs the process is allowed to run on
+     * @return
+     */
+    std::set<int> get_allowed_cpus() {
+        std::set<int> result;
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if(sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for(int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if(CPU_ISSET(cpu, &set))
+                    result.insert(cpu);
+            }
+        }
+#endif
+        if(result.empty()) {
+            const int num_cpus = std::max(1u, std::thread::hardware_concurrency());
+            for(int cpu = 0; cpu < num_cpus; ++cpu) {
+                result.insert(cpu);
+            }
+        }
+        return result;
+    }
+
+    std::vector<numa_node> load_numa_topology() {
+        const std::set<int> allowed = get_allowed_cpus();
+        std::vector<numa_node> result;
+
+        const boost::filesystem::path nodes_path = "/sys/devices/system/node";
+        boost::system::error_code error;
+        if(boost::filesystem::is_directory(nodes_path, error)) {
+            for(const auto &entry : boost::filesystem::directory_iterator(nodes_path, error)) {
+                const std::string name = entry.path().filename().string();
+                if(!boost::starts_with(name, "node") || name.size() == 4 ||
+                   name.find_first_not_of("0123456789", 4) != std::string::npos)
+                    continue;
+                std::ifstream in((entry.path() / "cpulist").string());
+                std::string list;
+                if(!std::getline(in, list))
+                    continue;
+                numa_node node;
+                node.id = std::stoi(name.substr(4));
+                for(int cpu : parse_cpu_list(list)) {
+                    if(allowed.find(cpu) != allowed.end())
+                        node.cpus.push_back(cpu);
+                }
+                if(!node.cpus.empty())
+                    result.emplace_back(std::move(node));
+            }
+        }
+
+        // Fall back to a single node
+        if(result.empty()) {
+            numa_node node;
+            node.cpus.assign(allowed.begin(), allowed.end());
+            result.emplace_back(std::move(node));
+        }
+
+        std::sort(result.begin(), result.end(), [](const numa_node &lhs, const numa_node &rhs) {
+            return lhs.id < rhs.id;
+        });
+        return result;
+    }
+}
+
+const std::vector<numa_node> &misaxx::utils::get_numa_topology() {
+    static const std::vector<numa_node> topology = load_numa_topology();
+    return topology;
+}
+
+int misaxx::utils::get_numa_node_of_cpu(int t_cpu) {
+    for(const numa_node &node : get_numa_topology()) {
+        if(std::find(node.cpus.begin(), node.cpus.end(), t_cpu) != node.cpus.end())
+            return node.id;
+    }
+    return 0;
+}
+
+std::vector<int> misaxx::utils::get_thread_affinity(const std::string &t_mode, int t_num_threads) {
+    std::vector<int> result;
+    if(t_mode.empty() || t_mode == "none")
+        return result;
+
+    const auto &topology = get_numa_topology();
+    if(t_mode == "compact") {
+        std::vector<int> cpus;
+        for(const numa_node &node : topology) {
+            cpus.insert(cpus.end(), node.cpus.begin(), node.cpus.end());
+        }
+        for(int thread = 0; thread < t_num_threads; ++thread) {
+            result.push_back(cpus[thread % cpus.size()]);
+        }
+    }
+    else if(t_mode == "scatter") {
+        std::vector<size_t> next_cpu(topology.size(), 0);
+        for(int thread = 0; thread < t_num_threads; ++thread) {
+            const numa_node &node = topology[thread % topology.size()];
+            size_t &next = next_cpu[thread % topology.size()];
+            result.push_back(node.cpus[next++ % node.cpus.size()]);
+        }
+    }
+    else {
+        const std::vector<int> cpus = parse_cpu_list(t_mode);
+        if(cpus.empty())
+            throw std::runtime_error("Invalid thread affinity " + t_mode);
+        for(int thread = 0; thread < t_num_threads; ++thread) {
+            result.push_back(cpus[thread % cpus.size()]);
+        }
+    }
+    return result;
+}
+
+bool misaxx::utils::set_current_thread_affinity(int t_cpu) {
+#ifdef __linux__
+    if(t_cpu < 0 || t_cpu >= CPU_SETSIZE)
+        return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(t_cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
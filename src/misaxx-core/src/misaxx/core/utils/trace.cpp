@@ -0,0 +1,161 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#include <misaxx/core/utils/trace.h>
+#include <misaxx/core/utils/work_stealing_pool.h>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+using namespace misaxx::utils;
+
+namespace {
+
+    struct trace_event {
+        const char *category;
+        std::string name;
+        trace_span::clock::time_point start;
+        trace_span::clock::time_point end;
+    };
+
+    /**
+     * Ring buffer that is only written by its thread
+     */
+    struct trace_buffer {
+        /**
+         * Maximum number of spans per thread
+         */
+        static constexpr size_t capacity = 1 << 18;
+
+        int id;
+        std::string thread_name;
+        std::vector<trace_event> events;
+        size_t next = 0;
+        size_t dropped = 0;
+
+        void add(trace_event t_event) {
+            if(events.size() < capacity) {
+                events.emplace_back(std::move(t_event));
+            }
+            else {
+                events[next] = std::move(t_event);
+                ++dropped;
+            }
+            next = (next + 1) % capacity;
+        }
+    };
+
+    std::atomic<bool> tracing { false };
+
+    trace_span::clock::time_point trace_start = trace_span::clock::now();
+
+    /**
+     * All buffers that were created. Buffers are kept after their thread ended.
+     */
+    std::vector<std::shared_ptr<trace_buffer>> buffers;
+
+    std::mutex buffers_mutex;
+
+    trace_buffer &get_thread_buffer() {
+        thread_local std::shared_ptr<trace_buffer> buffer;
+        if(!buffer) {
+            buffer = std::make_shared<trace_buffer>();
+            const int worker = work_stealing_pool::get_current_thread_index();
+            std::lock_guard<std::mutex> lock(buffers_mutex);
+            buffer->id = static_cast<int>(buffers.size());
+            buffer->thread_name = worker >= 0 ? "Worker " + std::to_string(worker) : "Thread " + std::to_string(buffer->id);
+            buffers.push_back(buffer);
+        }
+        return *buffer;
+    }
+
+    double to_microseconds(trace_span::clock::duration t_duration) {
+        return std::chrono::duration<double, std::micro>(t_duration).count();
+    }
+}
+
+void misaxx::utils::set_tracing(bool t_enabled) {
+    if(t_enabled) {
+        std::lock_guard<std::mutex> lock(buffers_mutex);
+        for(const auto &buffer : buffers) {
+            buffer->events.clear();
+            buffer->next = 0;
+            buffer->dropped = 0;
+        }
+        trace_start = trace_span::clock::now();
+    }
+    tracing = t_enabled;
+}
+
+bool misaxx::utils::is_tracing() {
+    return tracing.load(std::memory_order_relaxed);
+}
+
+void misaxx::utils::write_trace(const boost::filesystem::path &t_path) {
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+    std::ofstream out;
+    out.open(t_path.string());
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for(const auto &buffer : buffers) {
+        if(buffer->events.empty())
+            continue;
+        if(!first)
+            out << ",";
+        first = false;
+        nlohmann::json metadata {
+                { "name", "thread_name" }, { "ph", "M" }, { "pid", 1 }, { "tid", buffer->id },
+                { "args", { { "name", buffer->thread_name } } }
+        };
+        out << "\n" << metadata;
+        for(const trace_event &event : buffer->events) {
+            out << ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->id
+                << ",\"cat\":" << nlohmann::json(event.category)
+                << ",\"name\":" << nlohmann::json(event.name)
+                << ",\"ts\":" << to_microseconds(event.start - trace_start)
+                << ",\"dur\":" << to_microseconds(event.end - event.start) << "}";
+        }
+        if(buffer->dropped > 0) {
+            nlohmann::json dropped {
+                    { "name", "Dropped " + std::to_string(buffer->dropped) + " older spans" }, { "ph", "i" }, { "s", "t" },
+                    { "pid", 1 }, { "tid", buffer->id }, { "ts", 0 }
+            };
+            out << ",\n" << dropped;
+        }
+    }
+    out << "\n]}\n";
+}
+
+trace_span::trace_span(const char *t_category, std::string t_name) {
+    if(is_tracing()) {
+        m_category = t_category;
+        m_name = std::move(t_name);
+        m_start = clock::now();
+    }
+}
+
+trace_span::trace_span(const char *t_category, const char *t_name) {
+    if(is_tracing()) {
+        m_category = t_category;
+        m_name = t_name;
+        m_start = clock::now();
+    }
+}
+
+trace_span::~trace_span() {
+    if(m_category != nullptr && is_tracing()) {
+        get_thread_buffer().add(trace_event { m_category, std::move(m_name), m_start, clock::now() });
+    }
+}
@@ -0,0 +1,192 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#include <misaxx/core/utils/work_stealing_pool.h>
+#include <misaxx/core/utils/thread_affinity.h>
+#include <misaxx/core/utils/log.h>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace misaxx::utils;
+
+namespace {
+    thread_local const work_stealing_pool *current_pool = nullptr;
+    thread_local int current_thread_index = -1;
+}
+
+work_stealing_pool::work_stealing_pool(int t_num_threads, std::vector<int> t_cpus, exception_handler_type t_exception_handler) :
+        m_exception_handler(std::move(t_exception_handler)) {
+    if(t_num_threads < 1)
+        throw std::runtime_error("Invalid number of threads!");
+    if(!t_cpus.empty() && t_cpus.size() != static_cast<size_t>(t_num_threads))
+        throw std::runtime_error("Invalid number of CPUs!");
+    for(int i = 0; i < t_num_threads; ++i) {
+        m_queues.emplace_back(std::make_unique<worker_queue>());
+        m_numa_nodes.push_back(t_cpus.empty() ? 0 : get_numa_node_of_cpu(t_cpus[i]));
+    }
+
+    // Steal from workers on the same node first, then from the next workers
+    for(int i = 0; i < t_num_threads; ++i) {
+        std::vector<size_t> order;
+        for(int j = 1; j < t_num_threads; ++j) {
+            order.push_back(static_cast<size_t>((i + j) % t_num_threads));
+        }
+        std::stable_partition(order.begin(), order.end(), [this, i](size_t t_other) {
+            return m_numa_nodes[t_other] == m_numa_nodes[i];
+        });
+        m_steal_orders.emplace_back(std::move(order));
+    }
+
+    for(int i = 0; i < t_num_threads; ++i) {
+        const int cpu = t_cpus.empty() ? -1 : t_cpus[i];
+        m_threads.emplace_back([this, i, cpu]() {
+            run_worker(i, cpu);
+        });
+    }
+}
+
+work_stealing_pool::~work_stealing_pool() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleep_mutex);
+        m_stop = true;
+    }
+    m_sleep_condition.notify_all();
+    for(std::thread &thread : m_threads) {
+        thread.join();
+    }
+}
+
+void work_stealing_pool::submit(work_stealing_pool::job_type t_job) {
+    submit(std::move(t_job), -1);
+}
+
+void work_stealing_pool::submit(work_stealing_pool::job_type t_job, int t_thread) {
+    size_t index;
+    if(t_thread >= 0 && t_thread < get_num_threads()) {
+        index = static_cast<size_t>(t_thread);
+    }
+    else if(current_pool == this) {
+        index = static_cast<size_t>(current_thread_index);
+    }
+    else {
+        index = m_next_external_queue++ % m_queues.size();
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+        m_queues[index]->jobs.emplace_back(std::move(t_job));
+    }
+    // The job must be in its queue before a woken worker looks for it
+    ++m_queued_jobs;
+
+    // Workers count themselves as sleeping before they check m_queued_jobs, so either they see the new job
+    // or the job sees them. The lock ensures that a worker that is about to sleep already waits for the notification.
+    if(m_sleeping_workers > 0) {
+        std::unique_lock<std::mutex> lock(m_sleep_mutex);
+        // Workers that are already woken up take the job without another notification
+        if(m_sleeping_workers > m_waking_workers) {
+            ++m_waking_workers;
+            lock.unlock();
+            m_sleep_condition.notify_one();
+        }
+    }
+}
+
+int work_stealing_pool::get_num_threads() const {
+    return static_cast<int>(m_threads.size());
+}
+
+int work_stealing_pool::get_current_thread_index() {
+    return current_thread_index;
+}
+
+bool work_stealing_pool::is_numa_aware() const {
+    return std::any_of(m_numa_nodes.begin(), m_numa_nodes.end(), [this](int t_node) {
+        return t_node != m_numa_nodes.front();
+    });
+}
+
+int work_stealing_pool::get_numa_node(int t_thread) const {
+    return m_numa_nodes.at(static_cast<size_t>(t_thread));
+}
+
+void work_stealing_pool::run_worker(int t_index, int t_cpu) {
+    current_pool = this;
+    current_thread_index = t_index;
+    if(t_cpu >= 0 && !set_current_thread_affinity(t_cpu)) {
+        log_message(log_level::warning) << "Warning: Could not pin worker thread " << t_index << " to CPU " << t_cpu;
+    }
+
+    while(true) {
+        job_type job;
+        if(take_job(static_cast<size_t>(t_index), job)) {
+            run_job(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleep_mutex);
+        ++m_sleeping_workers;
+        while(!m_stop && m_queued_jobs <= 0) {
+            m_sleep_condition.wait(lock);
+            // Also counts spurious wake-ups, which at worst causes an additional notification
+            if(m_waking_workers > 0)
+                --m_waking_workers;
+        }
+        --m_sleeping_workers;
+        if(m_stop)
+            break;
+    }
+
+    current_pool = nullptr;
+    current_thread_index = -1;
+}
+
+void work_stealing_pool::run_job(work_stealing_pool::job_type &t_job) {
+    try {
+        t_job();
+    }
+    catch(...) {
+        if(m_exception_handler) {
+            m_exception_handler(std::current_exception());
+        }
+        else {
+            log_message(log_level::error) << "Error: Uncaught exception in worker thread " << current_thread_index;
+        }
+    }
+}
+
+bool work_stealing_pool::take_job(size_t t_index, work_stealing_pool::job_type &t_job) {
+    // Own queue: newest job first
+    {
+        worker_queue &queue = *m_queues[t_index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if(!queue.jobs.empty()) {
+            t_job = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+            --m_queued_jobs;
+            return true;
+        }
+    }
+
+    // Other queues: oldest job first
+    for(size_t other : m_steal_orders[t_index]) {
+        worker_queue &queue = *m_queues[other];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if(!queue.jobs.empty()) {
+            t_job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            --m_queued_jobs;
+            return true;
+        }
+    }
+
+    return false;
+}
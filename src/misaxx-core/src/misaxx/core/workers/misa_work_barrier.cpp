@@ -0,0 +1,51 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#include "misa_work_barrier.h"
+
+using namespace misaxx;
+
+misa_work_barrier::misa_work_barrier(const misa_worker::node &t_node, const misa_worker::module &t_module) : misa_worker(t_node, t_module) {
+}
+
+std::shared_ptr<misa_work_node> misa_work_barrier::create(const std::shared_ptr<misa_work_node> &t_parent, depencencies_t t_dependencies) {
+    const misa_worker::module module = t_parent->get_or_create_instance()->get_module();
+    // Unique names keep the barriers apart in the runtime log and the cost history
+    const std::string name = "barrier-" + std::to_string(t_parent->get_children().size());
+    auto nd = t_parent->make_child(name, [&module](const std::shared_ptr<misa_work_node> &t_node) {
+        return std::make_shared<misa_work_barrier>(t_node, module);
+    });
+    nd->get_or_create_instance();
+    nd->get_dependencies() = std::move(t_dependencies);
+    return nd;
+}
+
+void misa_work_barrier::create_parameters(misa_parameter_builder &) {
+}
+
+void misa_work_barrier::prepare_work() {
+    if(!static_cast<bool>(m_parameter_builder)) {
+        m_parameter_builder = std::make_unique<misa_parameter_builder>(*this);
+    }
+}
+
+void misa_work_barrier::execute_work() {
+}
+
+bool misa_work_barrier::is_parallelizeable() const {
+    // Nothing to do, so the runtime finishes the barrier without a worker thread
+    return false;
+}
+
+const misa_parameter_builder &misa_work_barrier::get_parameters() const {
+    return *m_parameter_builder;
+}
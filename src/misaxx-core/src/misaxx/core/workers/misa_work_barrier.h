@@ -0,0 +1,52 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#pragma once
+
+#include <misaxx/core/misa_worker.h>
+#include <misaxx/core/workers/misa_work_dependency_segment.h>
+
+namespace misaxx {
+
+    /**
+     * Synthetic worker without any work that waits for a set of dependencies.
+     * Groups let their workers depend on one barrier instead of copying all dependencies into each worker.
+     * This turns N x M dependency edges into N + M edges.
+     */
+    struct misa_work_barrier : public misa_worker {
+
+        misa_work_barrier(const node &t_node, const module &t_module);
+
+        /**
+         * Creates a barrier node as child of the given node.
+         * It is named "barrier-<n>", where n is its index among the children of the parent.
+         * @param t_parent Parent of the barrier. Usually the dispatcher that builds the group.
+         * @param t_dependencies The dependencies the barrier waits for
+         * @return
+         */
+        static std::shared_ptr<misa_work_node> create(const std::shared_ptr<misa_work_node> &t_parent, depencencies_t t_dependencies);
+
+        void create_parameters(misa_parameter_builder &t_parameters) override;
+
+        void prepare_work() override;
+
+        void execute_work() override;
+
+        bool is_parallelizeable() const override;
+
+        const misa_parameter_builder &get_parameters() const override;
+
+    private:
+
+        std::unique_ptr<misa_parameter_builder> m_parameter_builder;
+    };
+}
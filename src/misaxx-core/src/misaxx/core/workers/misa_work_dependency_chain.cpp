@@ -38,9 +38,11 @@ void misa_work_dependency_chain::assign(std::shared_ptr<misaxx::misa_work_node>
     if (m_locked) {
         throw std::runtime_error("Cannot assign nodes to this chain after it has been used as dependency!");
     }
-    m_as_dependencies.insert(t_node);
-    t_node->get_dependencies() = m_consecutive_dependencies;
-    m_consecutive_dependencies.insert(std::move(t_node));
+    // The node only depends on its predecessor, which already waits for all previous links.
+    // This keeps the number of dependencies linear in the length of the chain.
+    t_node->get_dependencies() = std::move(m_consecutive_dependencies);
+    m_consecutive_dependencies = { t_node };
+    m_as_dependencies = { std::move(t_node) };
 }
 
 void misa_work_dependency_chain::add_dependency(misa_work_dependency_segment &t_segment) {
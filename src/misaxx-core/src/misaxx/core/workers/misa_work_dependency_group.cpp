@@ -12,6 +12,7 @@
 
 #include <misaxx/core/workers/misa_work_dependency_group.h>
 #include <misaxx/core/misa_worker.h>
+#include "misa_work_barrier.h"
 
 using namespace misaxx;
 
@@ -43,8 +44,25 @@ void misa_work_dependency_group::assign(std::shared_ptr<misaxx::misa_work_node>
         throw std::runtime_error("Cannot assign nodes to this group after it has been used as dependency!");
     }
     auto &nd = *t_node;
+    if(!m_dependency_locked) {
+        // The assigned workers wait for the dependencies, so later segments only need to wait for the workers
+        for(const auto &dep : m_dependencies) {
+            m_as_dependencies.erase(dep);
+        }
+        nd.get_dependencies() = m_dependencies;
+    }
+    else {
+        // Further workers wait for a single barrier instead of copying all dependencies
+        const auto parent = t_node->get_parent().lock();
+        if(!static_cast<bool>(m_barrier) && m_dependencies.size() > 1 && static_cast<bool>(parent)) {
+            m_barrier = misa_work_barrier::create(parent, m_dependencies);
+        }
+        if(static_cast<bool>(m_barrier))
+            nd.get_dependencies() = { m_barrier };
+        else
+            nd.get_dependencies() = m_dependencies;
+    }
     m_as_dependencies.insert(std::move(t_node));
-    nd.get_dependencies() = m_dependencies;
     m_dependency_locked = true;
 }
 
@@ -12,18 +12,37 @@
 
 #include <misaxx/core/misa_task.h>
 #include "misa_work_node_impl.h"
+#include <mutex>
+#include <unordered_set>
 
 using namespace misaxx;
 
+namespace {
+    /**
+     * Returns the interned copy of a node name.
+     * Nodes with the same name (e.g. all tasks of one type) share a single string.
+     * Thread-safe.
+     * @param t_name
+     * @return
+     */
+    const std::string &intern_work_node_name(const std::string &t_name) {
+        // Never destroyed, as nodes might outlive static objects
+        static std::mutex *mutex = new std::mutex();
+        static std::unordered_set<std::string> *names = new std::unordered_set<std::string>();
+        std::lock_guard<std::mutex> lock(*mutex);
+        return *names->insert(t_name).first;
+    }
+}
+
 misa_work_node_impl::misa_work_node_impl(const std::string &t_name,
                                const std::shared_ptr<misa_work_node> &t_parent,
-                               misa_work_node_impl::instantiator_type t_instantiator) : m_name(t_name),
+                               misa_work_node_impl::instantiator_type t_instantiator) : m_name(&intern_work_node_name(t_name)),
                                                                                    m_parent(t_parent),
                                                                                    m_instantiator(std::move(t_instantiator)) {
 }
 
 const std::string &misa_work_node_impl::get_name() const {
-    return m_name;
+    return *m_name;
 }
 
 const std::weak_ptr<misa_work_node> misa_work_node_impl::get_parent() const {
@@ -35,24 +54,10 @@ bool misa_work_node_impl::is_parallelizeable() {
 }
 
 misa_work_subtree_status misa_work_node_impl::get_subtree_status() const {
-    if(dynamic_cast<const misa_task*>(m_instance.get()) != nullptr) {
-        // Tasks never build a subtree
-        return misa_work_subtree_status ::complete;
-    }
-    if(m_status == misa_worker_status::done) {
+    if(m_status == misa_worker_status::done || m_incomplete == 0) {
         return misa_work_subtree_status ::complete;
     }
-    else if(m_status == misa_worker_status::waiting) {
-        for(const auto &child : m_instance->get_node()->get_children()) {
-            if(child->get_subtree_status() != misa_work_subtree_status ::complete) {
-                return misa_work_subtree_status::incomplete;
-            }
-        }
-        return misa_work_subtree_status ::complete;
-    }
-    else {
-        return misa_work_subtree_status::incomplete;
-    }
+    return misa_work_subtree_status::incomplete;
 }
 
 misa_worker_status misa_work_node_impl::get_worker_status() const {
@@ -61,14 +66,7 @@ misa_worker_status misa_work_node_impl::get_worker_status() const {
         if(!static_cast<bool>(m_instance)) {
             throw std::logic_error("The worker is working without an instance!");
         }
-
-        for(const auto &child : m_instance->get_node()->get_children()) {
-            if(child->get_worker_status() != misa_worker_status::done) {
-                return misa_worker_status::working;
-            }
-        }
-
-        return misa_worker_status::done;
+        return m_unfinished == 0 ? misa_worker_status::done : misa_worker_status::working;
     }
     return m_status;
 }
@@ -78,7 +76,7 @@ void misa_work_node_impl::repeat_work() {
 }
 
 void misa_work_node_impl::skip_work() {
-    m_status = misa_worker_status ::done;
+    finish_work(misa_worker_status ::done);
 }
 
 void misa_work_node_impl::prepare_work() {
@@ -100,15 +98,20 @@ void misa_work_node_impl::work() {
     if(m_status != misa_worker_status::queued_repeat) {
         // If the worker has no children, we can already declare that it is finished
         if(instance->get_node()->get_children().empty())
-            m_status = misa_worker_status ::done;
+            finish_work(misa_worker_status ::done);
         else
-            m_status = misa_worker_status ::waiting;
+            finish_work(misa_worker_status ::waiting);
     }
 }
 
 std::shared_ptr<misaxx::misa_worker> misa_work_node_impl::get_or_create_instance() {
     if(!m_instance) {
         m_instance = m_instantiator(self());
+        m_instantiator = nullptr;
+        if(dynamic_cast<const misa_task*>(m_instance.get()) != nullptr && m_status != misa_worker_status::done) {
+            // Tasks never build a subtree
+            remove_incomplete();
+        }
     }
     return m_instance;
 }
@@ -116,6 +119,9 @@ std::shared_ptr<misaxx::misa_worker> misa_work_node_impl::get_or_create_instance
 std::shared_ptr<misa_work_node>
 misa_work_node_impl::make_child(const std::string &t_name, misa_work_node_impl::instantiator_type t_instantiator) {
     auto ptr = std::make_shared<misa_work_node_impl>(t_name, self(), std::move(t_instantiator));
+    // The new child is neither done nor complete
+    add_unfinished();
+    add_incomplete();
     m_children.push_back(ptr);
     return ptr;
 }
@@ -140,6 +146,24 @@ bool misa_work_node_impl::dependencies_satisfied() {
     return true;
 }
 
+void misa_work_node_impl::add_dependent(misa_work_node *t_node) {
+    m_dependents.push_back(t_node);
+}
+
+const std::vector<misa_work_node *> &misa_work_node_impl::get_dependents() const {
+    return m_dependents;
+}
+
+void misa_work_node_impl::set_unfinished_dependencies(size_t t_count) {
+    m_unfinished_dependencies = t_count;
+}
+
+bool misa_work_node_impl::notify_dependency_finished() {
+    if(m_unfinished_dependencies == 0)
+        throw std::logic_error("notify_dependency_finished() called on work node without unfinished dependencies");
+    return --m_unfinished_dependencies == 0;
+}
+
 std::shared_ptr<misa_work_node> misa_work_node_impl::self() {
     return shared_from_this();
 }
@@ -190,4 +214,45 @@ void misa_work_node_impl::set_nothread(bool value) {
     }
 }
 
+void misa_work_node_impl::finish_work(misa_worker_status t_status) {
+    const misa_worker_status previous = m_status.exchange(t_status);
+    if(previous == misa_worker_status::done || previous == misa_worker_status::waiting)
+        return;
+    remove_unfinished();
+    if(dynamic_cast<const misa_task*>(m_instance.get()) == nullptr) {
+        remove_incomplete();
+    }
+}
+
+void misa_work_node_impl::add_unfinished() {
+    if(m_unfinished++ == 0) {
+        if(auto parent = get_parent_impl())
+            parent->add_unfinished();
+    }
+}
+
+void misa_work_node_impl::remove_unfinished() {
+    if(--m_unfinished == 0) {
+        if(auto parent = get_parent_impl())
+            parent->remove_unfinished();
+    }
+}
+
+void misa_work_node_impl::add_incomplete() {
+    if(m_incomplete++ == 0) {
+        if(auto parent = get_parent_impl())
+            parent->add_incomplete();
+    }
+}
 
+void misa_work_node_impl::remove_incomplete() {
+    if(--m_incomplete == 0) {
+        if(auto parent = get_parent_impl())
+            parent->remove_incomplete();
+    }
+}
+
+std::shared_ptr<misa_work_node_impl> misa_work_node_impl::get_parent_impl() const {
+    // All nodes are created by misa_work_node::create_instance() or make_child()
+    return std::static_pointer_cast<misa_work_node_impl>(m_parent.lock());
+}
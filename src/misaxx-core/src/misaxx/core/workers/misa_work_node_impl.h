@@ -60,12 +60,14 @@ namespace misaxx {
 
         /**
          * Returns true if this node has all children. This means that the node iterator can stop watching this node for changes.
+         * Runs in constant time, as the number of incomplete subtrees is updated by the children.
          * @return
          */
         misa_work_subtree_status get_subtree_status() const override;
 
         /**
          * Returns true if the node has no work to do
+         * Runs in constant time, as the number of unfinished children is updated by the children.
          * @return
          */
         misa_worker_status get_worker_status() const override;
@@ -145,6 +147,14 @@ namespace misaxx {
          */
         bool dependencies_satisfied() override;
 
+        void add_dependent(misa_work_node *t_node) override;
+
+        const std::vector<misa_work_node *> &get_dependents() const override;
+
+        void set_unfinished_dependencies(size_t t_count) override;
+
+        bool notify_dependency_finished() override;
+
         /**
         * Returns a managed pointer to this node
         * @return
@@ -160,9 +170,41 @@ namespace misaxx {
     private:
 
         /**
-         * Name of this node
+         * Increments the number of unfinished workers in this subtree and notifies the parent if this node was done
+         */
+        void add_unfinished();
+
+        /**
+         * Decrements the number of unfinished workers in this subtree and notifies the parent if this node is done
+         */
+        void remove_unfinished();
+
+        /**
+         * Increments the number of incomplete subtrees and notifies the parent if the subtree was complete
          */
-        std::string m_name;
+        void add_incomplete();
+
+        /**
+         * Decrements the number of incomplete subtrees and notifies the parent if the subtree is complete
+         */
+        void remove_incomplete();
+
+        /**
+         * Sets the status to done or waiting and updates the counts of the parents
+         * @param t_status
+         */
+        void finish_work(misa_worker_status t_status);
+
+        /**
+         * Returns the parent implementation or nullptr if there is no parent
+         * @return
+         */
+        std::shared_ptr<misa_work_node_impl> get_parent_impl() const;
+
+        /**
+         * Name of this node. Interned by intern_work_node_name().
+         */
+        const std::string *m_name;
 
         /**
          * Pointer to the parent
@@ -179,18 +221,41 @@ namespace misaxx {
          */
         std::unordered_set<std::shared_ptr<misa_work_node>> m_dependencies;
 
+        /**
+         * Nodes that depend on this node
+         */
+        std::vector<misa_work_node *> m_dependents;
+
+        /**
+         * Number of dependencies that are not finished, yet
+         */
+        std::atomic<size_t> m_unfinished_dependencies { 0 };
+
         /**
          * Status of the worker
          */
         std::atomic<misa_worker_status> m_status = misa_worker_status::undone;
 
+        /**
+         * Number of children that are not done, plus one until this node finished its own work.
+         * The node is done if the count is zero.
+         */
+        std::atomic<size_t> m_unfinished { 1 };
+
+        /**
+         * Number of children with an incomplete subtree, plus one until this node is known to be a task or finished its own work.
+         * The subtree is complete if the count is zero.
+         */
+        std::atomic<size_t> m_incomplete { 1 };
+
         /**
          * The actual worker instance
          */
         instance_ptr_type m_instance;
 
         /**
-         * The instantiator responsible for creating the worker instance when requested
+         * The instantiator responsible for creating the worker instance when requested.
+         * Released after the instance was created.
          */
         instantiator_type m_instantiator;
 
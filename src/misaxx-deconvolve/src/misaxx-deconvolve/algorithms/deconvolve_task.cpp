@@ -256,3 +256,22 @@ void deconvolve_task::work() {
 
 
 }
+
+size_t deconvolve_task::get_memory_estimate() const {
+    auto module_interface = get_module_as<misaxx_deconvolve::module_interface>();
+    const cv::Size image_size = module_interface->m_input_image.get_size();
+    const cv::Size psf_size = module_interface->m_input_psf.get_size();
+    const cv::Size target_size(image_size.width + psf_size.width - 1, image_size.height + psf_size.height - 1);
+    const size_t padded_pixels = static_cast<size_t>(cv::getOptimalDFTSize(target_size.width)) *
+                                 static_cast<size_t>(cv::getOptimalDFTSize(target_size.height));
+    const size_t image_pixels = static_cast<size_t>(image_size.area());
+
+    // The spectra Y, H, L and X
+    const size_t spectra = 4 * padded_pixels * sizeof(cv::Vec2f);
+    // The padded image, the shifted PSF (repeated 2x2 before cropping) and the inverse FFT
+    const size_t padded = (1 + 4 + 1) * padded_pixels * sizeof(float);
+    // The convolved input and the unpadded result
+    const size_t unpadded = 2 * image_pixels * sizeof(float);
+
+    return spectra + padded + unpadded;
+}
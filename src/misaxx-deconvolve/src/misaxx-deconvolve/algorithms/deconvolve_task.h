@@ -19,5 +19,11 @@ namespace misaxx_deconvolve {
         using misaxx::misa_task::misa_task;
 
         void work() override;
+
+        /**
+         * Estimates the padded FFT buffers from the image and PSF sizes
+         * @return
+         */
+        size_t get_memory_estimate() const override;
     };
 }
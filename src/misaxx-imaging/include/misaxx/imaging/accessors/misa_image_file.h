@@ -29,6 +29,12 @@ namespace misaxx::imaging {
          */
         cv::Mat clone() const;
 
+        /**
+         * Returns the size of the image. TIFF files are not loaded for this.
+         * @return
+         */
+        cv::Size get_size() const;
+
         /**
          * Writes image data into the current file
          * @param t_data
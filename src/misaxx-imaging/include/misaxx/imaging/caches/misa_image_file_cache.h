@@ -49,6 +49,10 @@ namespace misaxx::imaging {
 
         void push() override;
 
+        bool can_restore() const override;
+
+        void restore(const boost::filesystem::path &t_source) override;
+
         void do_link(const misa_image_description &t_description) override;
 
     protected:
@@ -0,0 +1,28 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#pragma once
+
+#include <misaxx/core/runtime/misa_runtime.h>
+
+namespace misaxx::imaging::utils {
+
+    /**
+     * Lets OpenCV run its parallel loops in the thread pool of the MISA++ runtime.
+     * OpenCV functions then only use the thread budget of the calling task instead of all cores.
+     * The backend is installed when the runtime starts. Call this function in main() before running the runtime.
+     * Requires OpenCV 4.5.2 or newer. Older versions of OpenCV run single-threaded instead if the runtime uses multiple threads.
+     * @param t_runtime
+     */
+    extern void install_parallel_backend(misaxx::misa_runtime &t_runtime);
+
+}
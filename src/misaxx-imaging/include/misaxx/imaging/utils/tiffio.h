@@ -29,6 +29,13 @@ namespace misaxx::imaging::utils {
      */
     extern cv::Mat tiffread(const boost::filesystem::path &t_path);
 
+    /**
+     * Reads the size of a TIFF image from its header without reading the pixels
+     * @param t_path
+     * @return
+     */
+    extern cv::Size tiffsize(const boost::filesystem::path &t_path);
+
     /**
      * Writes a cv::Mat to TIFF. Supports all types supported by OpenCV
      * @param t_img
@@ -11,11 +11,22 @@
  */
 
 #include <misaxx/imaging/accessors/misa_image_file.h>
+#include <misaxx/imaging/utils/tiffio.h>
 
 cv::Mat misaxx::imaging::misa_image_file::clone() const {
     return this->access_readonly().get().clone();
 }
 
+cv::Size misaxx::imaging::misa_image_file::get_size() const {
+    const boost::filesystem::path path = this->get_unique_location();
+    if(path.has_extension() && (path.extension().string() == ".tif" || path.extension().string() == ".tiff")) {
+        return misaxx::imaging::utils::tiffsize(path);
+    }
+    else {
+        return this->access_readonly().get().size();
+    }
+}
+
 void misaxx::imaging::misa_image_file::write(cv::Mat t_data) {
     this->access_write().set(std::move(t_data));
 }
@@ -69,3 +69,11 @@ misaxx::imaging::misa_image_file_cache::produce_description(const boost::filesys
     t_pattern.apply(result, t_location);
     return result;
 }
+
+bool misaxx::imaging::misa_image_file_cache::can_restore() const {
+    return true;
+}
+
+void misaxx::imaging::misa_image_file_cache::restore(const boost::filesystem::path &t_source) {
+    restore_unique_location(t_source);
+}
@@ -0,0 +1,76 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <opencv2/core.hpp>
+#include <opencv2/core/version.hpp>
+#include <misaxx/core/runtime/misa_runtime.h>
+#include <misaxx/core/utils/work_stealing_pool.h>
+#include <misaxx/imaging/utils/parallel_backend.h>
+
+#if CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && (CV_VERSION_MINOR > 5 || (CV_VERSION_MINOR == 5 && CV_VERSION_REVISION >= 2)))
+#define MISAXX_IMAGING_WITH_PARALLEL_BACKEND
+#include <opencv2/core/parallel/parallel_backend.hpp>
+#endif
+
+#ifdef MISAXX_IMAGING_WITH_PARALLEL_BACKEND
+namespace {
+
+    /**
+     * OpenCV parallel backend that runs the stripes of cv::parallel_for_ as jobs of the MISA++ runtime
+     */
+    class misa_parallel_backend : public cv::parallel::ParallelForAPI {
+    public:
+        int getThreadNum() const override {
+            return std::max(0, misaxx::utils::work_stealing_pool::get_current_thread_index());
+        }
+
+        int getNumThreads() const override {
+            return misaxx::misa_runtime::instance().get_thread_budget();
+        }
+
+        int setNumThreads(int) override {
+            // The number of threads is controlled by the runtime
+            return getNumThreads();
+        }
+
+        void parallel_for(int tasks, FN_parallel_for_body_cb_t body_callback, void *callback_data) override {
+            misaxx::misa_runtime::instance().parallel_for(tasks, [body_callback, callback_data](int task) {
+                body_callback(task, task + 1, callback_data);
+            });
+        }
+
+        const char *getName() const override {
+            return "misaxx";
+        }
+    };
+}
+#endif
+
+void misaxx::imaging::utils::install_parallel_backend(misaxx::misa_runtime &t_runtime) {
+#ifdef MISAXX_IMAGING_WITH_PARALLEL_BACKEND
+    t_runtime.add_start_hook([](misaxx::misa_runtime &) {
+        static std::once_flag installed;
+        std::call_once(installed, []() {
+            cv::parallel::setParallelForBackend(std::make_shared<misa_parallel_backend>(), false);
+        });
+    });
+#else
+    t_runtime.add_start_hook([](misaxx::misa_runtime &t_started_runtime) {
+        // OpenCV cannot use the pool of the runtime. The thread count of OpenCV is global, so each call
+        // runs single-threaded if the runtime already works in parallel.
+        cv::setNumThreads(t_started_runtime.get_num_threads() > 1 ? 1 : -1);
+    });
+#endif
+}
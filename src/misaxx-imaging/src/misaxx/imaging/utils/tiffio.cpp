@@ -14,6 +14,7 @@
 #include <tiff.h>
 #include <tiffio.h>
 #include <boost/filesystem.hpp>
+#include <misaxx/core/utils/metrics.h>
 
 /**
      * RAII wrapper around libtiff
@@ -204,11 +205,26 @@ cv::Mat misaxx::imaging::utils::tiffread(const boost::filesystem::path &t_path)
     for(int row = 0; row < reader.get_image_height(); ++row) {
         reader.read_row_(result.ptr(row), row);
     }
+
+    static misaxx::utils::metric_counter &files = misaxx::utils::get_metric("io/tiffread/files");
+    static misaxx::utils::metric_counter &bytes = misaxx::utils::get_metric("io/tiffread/bytes");
+    files.add();
+    bytes.add(result.total() * result.elemSize());
     return result;
 }
 
+cv::Size misaxx::imaging::utils::tiffsize(const boost::filesystem::path &t_path) {
+    tiff_reader reader {t_path.string()};
+    return reader.get_size();
+}
+
 void misaxx::imaging::utils::tiffwrite(const cv::Mat &t_img, const boost::filesystem::path &t_path, tiff_compression t_compression) {
 
+    static misaxx::utils::metric_counter &files = misaxx::utils::get_metric("io/tiffwrite/files");
+    static misaxx::utils::metric_counter &bytes = misaxx::utils::get_metric("io/tiffwrite/bytes");
+    files.add();
+    bytes.add(t_img.total() * t_img.elemSize());
+
     if(t_img.channels() > 1) {
         if(boost::filesystem::exists(t_path)) {
             boost::filesystem::remove(t_path);
@@ -50,3 +50,15 @@ void misaxx_kidney_glomeruli::glomeruli_filtering::create_parameters(misaxx::mis
             .document_description("If enabled, the quantification results will only contain valid glomeruli.");
     m_invert = t_parameters.create_algorithm_parameter<bool>("invert", false).document_title("Invert filter").document_description("If true, valid glomeruli are removed, instead");
 }
+
+void misaxx_kidney_glomeruli::glomeruli_filtering::create_cache_usage(cache_usage &t_caches) {
+    auto module = get_module_as<module_interface>();
+    t_caches.read(module->m_output_quantification);
+    if(m_enable_label_filtering.query()) {
+        t_caches.read(module->m_output_segmented3d);
+        t_caches.write(module->m_output_segmented3d);
+    }
+    if(m_enable_quantification_filtering.query()) {
+        t_caches.write(module->m_output_quantification);
+    }
+}
@@ -26,6 +26,8 @@ namespace misaxx_kidney_glomeruli {
         void work() override;
 
         void create_parameters(misaxx::misa_parameter_builder &t_parameters) override;
+
+        void create_cache_usage(cache_usage &t_caches) override;
     };
 }
 
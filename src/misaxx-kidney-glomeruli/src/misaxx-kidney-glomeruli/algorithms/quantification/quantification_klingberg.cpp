@@ -96,3 +96,8 @@ void quantification_klingberg::create_parameters(misa_parameter_builder &t_param
     m_glomeruli_min_rad = t_parameters.create_algorithm_parameter<double>("glomeruli-min-rad", 15);
     m_glomeruli_max_rad = t_parameters.create_algorithm_parameter<double>("glomeruli-max-rad", 65);
 }
+
+void quantification_klingberg::create_cache_usage(cache_usage &t_caches) {
+    t_caches.read(m_input_segmented3d);
+    t_caches.write(get_module_as<module_interface>()->m_output_quantification);
+}
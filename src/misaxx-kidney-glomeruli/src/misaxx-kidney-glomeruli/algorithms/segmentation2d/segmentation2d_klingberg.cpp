@@ -211,6 +211,19 @@ void segmentation2d_klingberg::work() {
     m_output_segmented2d.write(std::move(img8u));
 }
 
+size_t segmentation2d_klingberg::get_memory_estimate() const {
+    const size_t pixels = m_input_autofluoresence.get_size_x() * m_input_autofluoresence.get_size_y();
+
+    // The autofluorescence plane (at most 32 bit) and the tissue mask
+    const size_t inputs = pixels * (sizeof(float) + sizeof(uchar));
+    // The float copy and its clone for the median filter
+    const size_t preprocessing = 2 * pixels * sizeof(float);
+    // The 8-bit image, the clones for the morphological operations and thresholding, and the sorted kidney pixels
+    const size_t segmentation = 3 * pixels * sizeof(uchar);
+
+    return inputs + preprocessing + segmentation;
+}
+
 void segmentation2d_klingberg::create_parameters(misa_parameter_builder &t_parameters) {
     segmentation2d_base::create_parameters(t_parameters);
     m_median_filter_size = t_parameters.create_algorithm_parameter<int>("median-filter-size", 3);
@@ -219,3 +232,9 @@ void segmentation2d_klingberg::create_parameters(misa_parameter_builder &t_param
     m_threshold_percentile = t_parameters.create_algorithm_parameter<double>("threshold-percentile", 75);
     m_threshold_factor = t_parameters.create_algorithm_parameter<double>("threshold-factor", 1.5);
 }
+
+void segmentation2d_klingberg::create_cache_usage(cache_usage &t_caches) {
+    t_caches.read(m_input_tissue);
+    t_caches.read(m_input_autofluoresence);
+    t_caches.write(m_output_segmented2d);
+}
@@ -27,6 +27,14 @@ namespace misaxx_kidney_glomeruli {
 
         void work() override;
 
+        /**
+         * Estimates the intermediate images from the plane size
+         * @return
+         */
+        size_t get_memory_estimate() const override;
+
         void create_parameters(misaxx::misa_parameter_builder &t_parameters) override;
+
+        void create_cache_usage(cache_usage &t_caches) override;
     };
 }
\ No newline at end of file
@@ -180,3 +180,8 @@ void misaxx_kidney_glomeruli::segmentation3d_klingberg::create_parameters(
     misa_task::create_parameters(t_parameters);
     m_max_glomerulus_radius = t_parameters.create_algorithm_parameter<double>("max-glomerulus-radius", 65);
 }
+
+void misaxx_kidney_glomeruli::segmentation3d_klingberg::create_cache_usage(cache_usage &t_caches) {
+    t_caches.read(m_input_segmented2d);
+    t_caches.write(m_output_segmented3d);
+}
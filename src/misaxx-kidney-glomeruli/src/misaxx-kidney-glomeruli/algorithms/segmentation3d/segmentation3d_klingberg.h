@@ -16,6 +16,8 @@ namespace misaxx_kidney_glomeruli {
         void work() override;
 
         void create_parameters(parameter_list &t_parameters) override;
+
+        void create_cache_usage(cache_usage &t_caches) override;
     };
 }
 
@@ -0,0 +1,310 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+// Synthetic task graphs that benchmark the scheduling overhead of the runtime. Each task checks that its dependencies
+// are done and spins for a fixed time.
+// The program creates <work-dir>/in with one folder per sample, runs the graph and prints the wall time, the
+// peak resident memory of the process and the number of errors. Usage:
+//   misaxx-microbench-dag [topology=wide] [size=100000] [samples=3] [threads=4] [work-us=0] [work-dir=misaxx-microbench-dag]
+//                         [exports=0] [samples-in-flight=0]
+// Each sample exports <exports> attachment caches. If <samples-in-flight> is set, only so many samples run at the same time.
+// Topologies (per sample):
+//   wide     One dispatcher with <size> child tasks, followed by 2000 tasks that depend on the dispatcher
+//   chain    <size> tasks that each depend on the previous one
+//   groups   A group of <size> tasks, followed by <size> tasks that depend on the group
+//   reduce   <size> tasks that check the results of misa_task::parallel_reduce() with bool and std::string values
+
+#include <misaxx/core/misa_module.h>
+#include <misaxx/core/misa_module_interface.h>
+#include <misaxx/core/misa_module_info.h>
+#include <misaxx/core/misa_task.h>
+#include <misaxx/core/runtime/misa_cli.h>
+#include <misaxx/core/runtime/detail/misa_cli.h>
+#include <misaxx/core/accessors/misa_exported_attachments.h>
+#include <misaxx/core/attachments/misa_quantity.h>
+#include <misaxx/core/attachments/misa_unit_numeric.h>
+#include <boost/filesystem/operations.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+using namespace misaxx;
+
+namespace {
+
+    const std::vector<std::string> topologies { "wide", "chain", "groups", "reduce" };
+
+    struct benchmark_settings {
+        std::string topology = "wide";
+        int size = 100000;
+        int samples = 3;
+        int threads = 4;
+        int work_us = 0;
+        boost::filesystem::path work_dir = "misaxx-microbench-dag";
+        int exports = 0;
+        int samples_in_flight = 0;
+    };
+
+    /**
+     * Number of exported attachment caches per sample
+     */
+    int g_exports = 0;
+
+    struct dag_interface : public misa_module_interface {
+        std::vector<misa_exported_attachments> exports;
+
+        void setup() override {
+            exports.resize(static_cast<size_t>(g_exports));
+            for(size_t i = 0; i < exports.size(); ++i) {
+                exports[i].suggest_export_location(filesystem, "export" + std::to_string(i) + "/data.json");
+                exports[i].access_attachments_readwrite().get().insert(misa_quantity<double, misa_unit_numeric>(i));
+            }
+        }
+    };
+
+    /**
+     * Time each task spins. Equal for all tasks.
+     */
+    int g_work_us = 0;
+
+    /**
+     * Number of tasks that started before their dependencies were done
+     */
+    std::atomic<int> g_errors { 0 };
+
+    struct spin_task : public misa_task {
+        using misa_task::misa_task;
+
+        void work() override {
+            for(const auto &dependency : get_node()->get_dependencies()) {
+                if(dependency->get_worker_status() != misa_worker_status::done)
+                    ++g_errors;
+            }
+            const auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(g_work_us);
+            while(std::chrono::steady_clock::now() < end) {
+            }
+        }
+    };
+
+    /**
+     * Compares parallel_reduce() with a sequential reduction
+     */
+    struct reduce_task : public spin_task {
+        using spin_task::spin_task;
+
+        void work() override {
+            spin_task::work();
+            const size_t count = 1000;
+
+            // Blocks of one bool each. Only one index maps to a different value.
+            for(size_t special = 0; special < count; special += 97) {
+                const bool any = parallel_reduce(count, false, [special](size_t i) { return i == special; },
+                        [](bool a, bool b) { return a || b; });
+                const bool all = parallel_reduce(count, true, [special](size_t i) { return i != special; },
+                        [](bool a, bool b) { return a && b; });
+                if(!any || all)
+                    ++g_errors;
+            }
+
+            // Values that are not trivially copyable and a combination that depends on the order
+            std::string expected;
+            for(size_t i = 0; i < count; ++i) {
+                expected += std::to_string(i % 10);
+            }
+            for(size_t grain : { 1, 7, 64 }) {
+                const std::string concatenated = parallel_reduce(count, std::string(), [](size_t i) { return std::to_string(i % 10); },
+                        [](std::string a, const std::string &b) { return a + b; }, grain);
+                if(concatenated != expected)
+                    ++g_errors;
+            }
+        }
+    };
+
+    struct children_dispatcher : public misa_dispatcher {
+        using misa_dispatcher::misa_dispatcher;
+
+        int size = 0;
+
+        void create_blueprints(blueprint_list &t_blueprints, parameter_list &) override {
+            t_blueprints.add(create_blueprint<spin_task>("task"));
+        }
+
+        void build(const blueprint_builder &t_builder) override {
+            for(int i = 0; i < size; ++i) {
+                t_builder.build<spin_task>("task");
+            }
+        }
+    };
+
+    struct dag_module : public misa_module<dag_interface> {
+        using misa_module<dag_interface>::misa_module;
+
+        misa_parameter<std::string> m_topology;
+        misa_parameter<int> m_size;
+
+        void create_blueprints(blueprint_list &t_blueprints, parameter_list &t_parameters) override {
+            m_topology = t_parameters.create_algorithm_parameter<std::string>("topology", "wide");
+            m_size = t_parameters.create_algorithm_parameter<int>("size", 100000);
+            t_blueprints.add(create_blueprint<spin_task>("task"));
+            t_blueprints.add(create_blueprint<children_dispatcher>("children"));
+            t_blueprints.add(create_blueprint<reduce_task>("reduce"));
+        }
+
+        void build(const blueprint_builder &t_builder) override {
+            const std::string topology = m_topology.query();
+            const int size = m_size.query();
+            if(topology == "wide") {
+                auto &children = t_builder.build<children_dispatcher>("children");
+                children.size = size;
+                group dispatcher;
+                dispatcher << children;
+                group dependents({{ dispatcher }});
+                for(int i = 0; i < 2000; ++i) {
+                    dependents << t_builder.build<spin_task>("task");
+                }
+            }
+            else if(topology == "chain") {
+                chain tasks;
+                for(int i = 0; i < size; ++i) {
+                    tasks >> t_builder.build<spin_task>("task");
+                }
+            }
+            else if(topology == "groups") {
+                group first;
+                for(int i = 0; i < size; ++i) {
+                    first << t_builder.build<spin_task>("task");
+                }
+                group second({{ first }});
+                for(int i = 0; i < size; ++i) {
+                    second << t_builder.build<spin_task>("task");
+                }
+            }
+            else if(topology == "reduce") {
+                group tasks;
+                for(int i = 0; i < size; ++i) {
+                    tasks << t_builder.build<reduce_task>("reduce");
+                }
+            }
+            else {
+                throw std::runtime_error("Unknown topology " + topology);
+            }
+        }
+    };
+
+    double get_peak_rss_mb() {
+#if defined(__unix__) || defined(__APPLE__)
+        rusage usage {};
+        getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+        return usage.ru_maxrss / 1024.0 / 1024.0;
+#else
+        return usage.ru_maxrss / 1024.0;
+#endif
+#else
+        return 0;
+#endif
+    }
+
+    boost::filesystem::path write_parameters(const benchmark_settings &t_settings) {
+        const boost::filesystem::path input_path = boost::filesystem::absolute(t_settings.work_dir / "in");
+        boost::filesystem::remove_all(input_path);
+        nlohmann::json parameters;
+        parameters["filesystem"]["source"] = "directories";
+        parameters["filesystem"]["input-directory"] = input_path.string();
+        parameters["filesystem"]["output-directory"] = boost::filesystem::absolute(t_settings.work_dir / "out").string();
+        for(int i = 0; i < t_settings.samples; ++i) {
+            const std::string name = "sample" + std::to_string(i);
+            boost::filesystem::create_directories(input_path / name);
+            parameters["samples"][name] = nlohmann::json::object();
+        }
+        parameters["algorithm"]["topology"] = t_settings.topology;
+        parameters["algorithm"]["size"] = t_settings.size;
+        parameters["runtime"]["num-threads"] = t_settings.threads;
+        if(t_settings.samples_in_flight > 0)
+            parameters["runtime"]["max-samples-in-flight"] = t_settings.samples_in_flight;
+
+        const boost::filesystem::path parameters_path = t_settings.work_dir / "parameters.json";
+        std::ofstream out(parameters_path.string());
+        out << std::setw(4) << parameters;
+        return parameters_path;
+    }
+}
+
+int main(int argc, const char **argv) {
+    benchmark_settings settings;
+    for(int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const auto separator = arg.find('=');
+        if(separator == std::string::npos) {
+            std::cerr << "Invalid argument " << arg << ". Expected key=value" << std::endl;
+            return 1;
+        }
+        const std::string key = arg.substr(0, separator);
+        const std::string value = arg.substr(separator + 1);
+        if(key == "topology")
+            settings.topology = value;
+        else if(key == "size")
+            settings.size = std::stoi(value);
+        else if(key == "samples")
+            settings.samples = std::stoi(value);
+        else if(key == "threads")
+            settings.threads = std::stoi(value);
+        else if(key == "work-us")
+            settings.work_us = std::stoi(value);
+        else if(key == "work-dir")
+            settings.work_dir = value;
+        else if(key == "exports")
+            settings.exports = std::stoi(value);
+        else if(key == "samples-in-flight")
+            settings.samples_in_flight = std::stoi(value);
+        else {
+            std::cerr << "Unknown argument " << key << std::endl;
+            return 1;
+        }
+    }
+
+    if(std::find(topologies.begin(), topologies.end(), settings.topology) == topologies.end()) {
+        std::cerr << "Unknown topology " << settings.topology << std::endl;
+        return 1;
+    }
+
+    g_work_us = settings.work_us;
+    g_exports = settings.exports;
+    boost::filesystem::create_directories(settings.work_dir);
+    const std::string parameters_path = write_parameters(settings).string();
+
+    misa_cli cli {};
+    misa_module_info info;
+    info.set_id("misaxx-microbench-dag");
+    info.set_version("1.0.0");
+    info.set_name("MISA++ scheduler benchmark");
+    cli.set_module_info(info);
+    cli.set_root_module<dag_module>("misaxx-microbench-dag");
+
+    std::vector<const char*> cli_argv { argv[0], "--parameters", parameters_path.c_str() };
+    const auto start = std::chrono::steady_clock::now();
+    const int result = cli.prepare_and_run(static_cast<int>(cli_argv.size()), cli_argv.data());
+    const double wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "topology\tsize\tsamples\tthreads\twork-us\twall-ms\tpeak-rss-mb\terrors\n";
+    std::cout << settings.topology << "\t" << settings.size << "\t" << settings.samples << "\t" << settings.threads << "\t" << settings.work_us << "\t"
+              << std::fixed << std::setprecision(0) << wall_ms << "\t" << get_peak_rss_mb() << "\t" << g_errors << std::endl;
+    return g_errors > 0 ? 1 : result;
+}
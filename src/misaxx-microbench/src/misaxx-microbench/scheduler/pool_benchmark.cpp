@@ -0,0 +1,148 @@
+/**
+ * Copyright by Ruman Gerst
+ * Research Group Applied Systems Biology - Head: Prof. Dr. Marc Thilo Figge
+ * https://www.leibniz-hki.de/en/applied-systems-biology.html
+ * HKI-Center for Systems Biology of Infection
+ * Leibniz Institute for Natural Product Research and Infection Biology - Hans Knöll Insitute (HKI)
+ * Adolf-Reichwein-Straße 23, 07745 Jena, Germany
+ *
+ * This code is licensed under BSD 2-Clause
+ * See the LICENSE file provided with this code for the full license.
+ */
+
+// Compares the work-stealing pool of the runtime with OpenMP tasks, which were used by the runtime before.
+// A dispatcher thread submits independent jobs one by one and waits for them, like the runtime dispatcher does
+// with ready nodes. Each job spins for a fixed time. Usage:
+//   misaxx-microbench-pool [threads=2,4,8,16,32,64] [jobs=20000] [work-us=20] [rounds=5]
+
+#include <misaxx/core/utils/work_stealing_pool.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+#ifdef MISAXX_MICROBENCH_WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+    using clock_type = std::chrono::steady_clock;
+
+    struct benchmark_settings {
+        std::vector<int> threads { 2, 4, 8, 16, 32, 64 };
+        int jobs = 20000;
+        int work_us = 20;
+        int rounds = 5;
+    };
+
+    void spin(int t_us) {
+        const auto end = clock_type::now() + std::chrono::microseconds(t_us);
+        while(clock_type::now() < end) {
+        }
+    }
+
+    double elapsed_ms(clock_type::time_point t_start) {
+        return std::chrono::duration<double, std::milli>(clock_type::now() - t_start).count();
+    }
+
+    double run_pool(const benchmark_settings &t_settings, int t_threads) {
+        misaxx::utils::work_stealing_pool pool { t_threads };
+        const auto start = clock_type::now();
+        for(int round = 0; round < t_settings.rounds; ++round) {
+            std::atomic<int> remaining { t_settings.jobs };
+            std::mutex mutex;
+            std::condition_variable finished;
+            for(int i = 0; i < t_settings.jobs; ++i) {
+                pool.submit([&]() {
+                    spin(t_settings.work_us);
+                    if(--remaining == 0) {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        finished.notify_all();
+                    }
+                });
+            }
+            std::unique_lock<std::mutex> lock(mutex);
+            finished.wait(lock, [&]() { return remaining == 0; });
+        }
+        return elapsed_ms(start);
+    }
+
+#ifdef MISAXX_MICROBENCH_WITH_OPENMP
+    double run_openmp(const benchmark_settings &t_settings, int t_threads) {
+        omp_set_num_threads(t_threads);
+        const auto start = clock_type::now();
+        #pragma omp parallel
+        {
+            #pragma omp master
+            {
+                for(int round = 0; round < t_settings.rounds; ++round) {
+                    for(int i = 0; i < t_settings.jobs; ++i) {
+                        #pragma omp task
+                        spin(t_settings.work_us);
+                    }
+                    #pragma omp taskwait
+                }
+            }
+        }
+        return elapsed_ms(start);
+    }
+#endif
+
+    std::vector<int> parse_list(const std::string &t_value) {
+        std::vector<int> result;
+        std::stringstream stream(t_value);
+        std::string item;
+        while(std::getline(stream, item, ',')) {
+            result.push_back(std::stoi(item));
+        }
+        return result;
+    }
+}
+
+int main(int argc, const char **argv) {
+    benchmark_settings settings;
+    for(int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const auto separator = arg.find('=');
+        if(separator == std::string::npos) {
+            std::cerr << "Invalid argument " << arg << ". Expected key=value" << std::endl;
+            return 1;
+        }
+        const std::string key = arg.substr(0, separator);
+        const std::string value = arg.substr(separator + 1);
+        if(key == "threads")
+            settings.threads = parse_list(value);
+        else if(key == "jobs")
+            settings.jobs = std::stoi(value);
+        else if(key == "work-us")
+            settings.work_us = std::stoi(value);
+        else if(key == "rounds")
+            settings.rounds = std::stoi(value);
+        else {
+            std::cerr << "Unknown argument " << key << std::endl;
+            return 1;
+        }
+    }
+
+    const double total_jobs = static_cast<double>(settings.jobs) * settings.rounds;
+    std::cout << "threads\tpool-ms\tpool-jobs/s";
+#ifdef MISAXX_MICROBENCH_WITH_OPENMP
+    std::cout << "\topenmp-ms\topenmp-jobs/s";
+#endif
+    std::cout << "\n";
+    for(int threads : settings.threads) {
+        const double pool_ms = run_pool(settings, threads);
+        std::cout << threads << "\t" << std::fixed << std::setprecision(1) << pool_ms << "\t" << std::setprecision(0) << total_jobs / pool_ms * 1000;
+#ifdef MISAXX_MICROBENCH_WITH_OPENMP
+        const double openmp_ms = run_openmp(settings, threads);
+        std::cout << "\t" << std::setprecision(1) << openmp_ms << "\t" << std::setprecision(0) << total_jobs / openmp_ms * 1000;
+#endif
+        std::cout << std::endl;
+    }
+    return 0;
+}
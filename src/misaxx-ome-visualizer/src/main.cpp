@@ -13,6 +13,7 @@
 #include <misaxx-ome-visualizer/module.h>
 #include <misaxx-ome-visualizer/module_info.h>
 #include <misaxx/core/runtime/misa_cli.h>
+#include <misaxx/imaging/utils/parallel_backend.h>
 
 using namespace misaxx;
 using namespace misaxx_ome_visualizer;
@@ -21,5 +22,6 @@ int main(int argc, const char** argv) {
     misa_cli cli {};
     cli.set_module_info(misaxx_ome_visualizer::module_info());
     cli.set_root_module<misaxx_ome_visualizer::module>("misaxx-ome-visualizer");
+    misaxx::imaging::utils::install_parallel_backend(cli);
     return cli.prepare_and_run(argc, argv);
 }
\ No newline at end of file
@@ -31,19 +31,26 @@ void misaxx_ome_visualizer::find_colormap_task::create_parameters(misaxx::misa_p
 
 void misaxx_ome_visualizer::find_colormap_task::work() {
     misaxx::ome::misa_ome_tiff images = get_module_as<module_interface>()->m_input;
-    std::unordered_set<int> label_colors;
-    for(size_t i = 0; i < images.size(); ++i) {
-        std::cout << "Analyzing color map (" << i << "/" << images.size() << ")\n";
+    std::cout << "Analyzing color map (" << images.size() << " planes)\n";
+    // The planes are analyzed by idle worker threads of the runtime
+    std::unordered_set<int> label_colors = parallel_reduce(images.size(), std::unordered_set<int>(), [&](size_t i) {
+        std::unordered_set<int> plane_colors;
         auto input_access = images.at(i).access_readonly();
         if(input_access.get().type() == CV_32S) {
             for(int y = 0; y < input_access.get().rows; ++y) {
                 const int *row = input_access.get().ptr<int>(y);
                 for(int x = 0; x < input_access.get().cols; ++x) {
-                    label_colors.insert(row[x]);
+                    plane_colors.insert(row[x]);
                 }
             }
         }
-    }
+        return plane_colors;
+    }, [](std::unordered_set<int> t_lhs, std::unordered_set<int> t_rhs) {
+        if(t_lhs.size() < t_rhs.size())
+            std::swap(t_lhs, t_rhs);
+        t_lhs.insert(t_rhs.begin(), t_rhs.end());
+        return t_lhs;
+    });
 
 
     if(!label_colors.empty()) {
@@ -23,6 +23,11 @@ void visualize_task::create_parameters(misa_parameter_builder &t_parameters) {
 
 }
 
+misa_resource_class visualize_task::get_resource_class() const {
+    // Recoloring is cheap compared to reading and writing the planes
+    return misa_resource_class::io;
+}
+
 void visualize_task::work() {
     auto input_access = m_input.access_readonly();
     auto output_access = m_output.access_write();
@@ -25,6 +25,8 @@ namespace misaxx_ome_visualizer {
         void work() override;
 
         void create_parameters(misaxx::misa_parameter_builder &t_parameters) override;
+
+        misaxx::misa_resource_class get_resource_class() const override;
     };
 }
 
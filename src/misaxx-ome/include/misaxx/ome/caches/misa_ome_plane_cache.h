@@ -45,6 +45,21 @@ namespace misaxx::ome {
 
         void do_link(const misa_ome_plane_description &t_description) override;
 
+        bool can_restore() const override;
+
+        /**
+         * Writes the plane as standard TIFF
+         * @param t_target
+         * @return false if the OME TIFF does not exist
+         */
+        bool save(const boost::filesystem::path &t_target) const override;
+
+        /**
+         * Writes a plane that was saved with save() into the OME TIFF
+         * @param t_source
+         */
+        void restore(const boost::filesystem::path &t_source) override;
+
         void set_tiff_io(std::shared_ptr<ome_tiff_io> t_tiff);
 
         std::shared_ptr<ome_tiff_io> get_tiff_io() const;
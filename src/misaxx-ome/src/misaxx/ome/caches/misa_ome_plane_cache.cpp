@@ -11,7 +11,10 @@
  */
 
 #include <misaxx/ome/caches/misa_ome_plane_cache.h>
+#include <misaxx/core/utils/log.h>
 #include <misaxx/ome/attachments/misa_ome_planes_location.h>
+#include <misaxx/imaging/utils/tiffio.h>
+#include <boost/filesystem/operations.hpp>
 #include "../utils/ome_tiff_io.h"
 
 cv::Mat &misaxx::ome::misa_ome_plane_cache::get() {
@@ -54,7 +57,27 @@ void misaxx::ome::misa_ome_plane_cache::do_link(const misaxx::ome::misa_ome_plan
         throw std::runtime_error("Cannot link OME TIFF plane without a TIFF IO!");
     }
     this->set_unique_location(this->get_location() / "planes" /  (misaxx::utils::to_string(t_description) + ".tif"));
-    std::cout << "[Cache] Linking OME TIFF plane @ " << t_description << "\n";
+    misaxx::utils::log_message(misaxx::utils::log_level::debug) << "[Cache] Linking OME TIFF plane @ " << t_description;
+}
+
+bool misaxx::ome::misa_ome_plane_cache::can_restore() const {
+    return true;
+}
+
+bool misaxx::ome::misa_ome_plane_cache::save(const boost::filesystem::path &t_target) const {
+    // The plane is read back from the finished OME TIFF
+    if(!boost::filesystem::exists(m_tiff->get_path()))
+        return false;
+    misaxx::imaging::utils::tiffwrite(m_tiff->read_plane(get_plane_location()), t_target, misaxx::imaging::utils::tiff_compression::lzw);
+    return true;
+}
+
+void misaxx::ome::misa_ome_plane_cache::restore(const boost::filesystem::path &t_source) {
+    auto lock = this->exclusive_lock();
+    lock.lock();
+    this->set(misaxx::imaging::utils::tiffread(t_source));
+    this->push();
+    misaxx::utils::cache<cv::Mat>::stash(std::move(lock));
 }
 
 void misaxx::ome::misa_ome_plane_cache::set_tiff_io(std::shared_ptr<misaxx::ome::ome_tiff_io> t_tiff) {
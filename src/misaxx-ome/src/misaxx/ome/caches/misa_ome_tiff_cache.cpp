@@ -11,6 +11,7 @@
  */
 
 #include <misaxx/ome/caches/misa_ome_tiff_cache.h>
+#include <misaxx/core/utils/log.h>
 #include <misaxx/ome/attachments/misa_ome_planes_location.h>
 #include <misaxx/core/runtime/misa_parameter_registry.h>
 #include <src/misaxx/ome/utils/ome_tiff_io.h>
@@ -51,13 +52,13 @@ void misaxx::ome::misa_ome_tiff_cache::do_link(const misaxx::ome::misa_ome_tiff_
     this->set_unique_location(misaxx::utils::make_preferred(this->get_unique_location()));
 
     if (boost::filesystem::exists(this->get_unique_location())) {
-        std::cout << "[Cache] Opening OME TIFF " << this->get_unique_location() << "\n";
+        misaxx::utils::log_message(misaxx::utils::log_level::info) << "[Cache] Opening OME TIFF " << this->get_unique_location();
         m_tiff = std::make_shared<ome_tiff_io>(this->get_unique_location());
 
         // Put the loaded metadata into the description
         this->describe()->template get<misa_ome_tiff_description>().metadata = m_tiff->get_metadata();
     } else {
-        std::cout << "[Cache] Creating OME TIFF " << this->get_unique_location() << "\n";
+        misaxx::utils::log_message(misaxx::utils::log_level::info) << "[Cache] Creating OME TIFF " << this->get_unique_location();
 
         // Create the TIFF and generate the image caches
         m_tiff = std::make_shared<ome_tiff_io>(this->get_unique_location(), t_description.metadata);
@@ -117,7 +118,7 @@ void misaxx::ome::misa_ome_tiff_cache::postprocess() {
     misaxx::misa_default_cache<misaxx::utils::memory_cache<std::vector<misa_ome_plane>>,
             misa_ome_tiff_pattern, misa_ome_tiff_description>::postprocess();
     if (m_disable_ome_tiff_writing_parameter.query()) {
-        std::cout << "[WARNING] No OME TIFF is written, because it is disabled by a parameter!" << "\n";
+        misaxx::utils::log_message(misaxx::utils::log_level::warning) << "[WARNING] No OME TIFF is written, because it is disabled by a parameter!";
         return;
     }
 
@@ -11,6 +11,9 @@
  */
 
 #include <src/misaxx/ome/utils/ome_tiff_io.h>
+#include <misaxx/core/utils/log.h>
+#include <misaxx/core/utils/trace.h>
+#include <misaxx/core/utils/metrics.h>
 #include <misaxx/ome/descriptions/misa_ome_plane_description.h>
 #include <misaxx/core/utils/string.h>
 #include <misaxx/imaging/utils/tiffio.h>
@@ -221,7 +224,8 @@ ome_tiff_io_impl::get_write_buffer_path(const misa_ome_plane_description &t_loca
 }
 
 void ome_tiff_io_impl::close_writer(bool remove_write_buffer) const {
-    std::cout << "[MISA++ OME] Writing results as OME TIFF " << m_path << " ... " << "\n";
+    misaxx::utils::trace_span span("ome", "write buffer flush");
+    misaxx::utils::log_message(misaxx::utils::log_level::info) << "[MISA++ OME] Writing results as OME TIFF " << m_path << " ... ";
     // Save the write buffer files into the path
     auto writer = std::make_shared<::ome::files::out::OMETIFFWriter>();
     auto metadata = std::static_pointer_cast<::ome::xml::meta::MetadataRetrieve>(m_metadata);
@@ -233,10 +237,14 @@ void ome_tiff_io_impl::close_writer(bool remove_write_buffer) const {
         writer->setCompression("LZW");
     }
 
+    static misaxx::utils::metric_counter &planes = misaxx::utils::get_metric("io/ome-tiff/planes-written");
+    static misaxx::utils::metric_counter &bytes = misaxx::utils::get_metric("io/ome-tiff/bytes-written");
     for(const auto &kv : m_write_buffer) {
-        std::cout << "[MISA++ OME] Writing results as OME TIFF " << m_path << " ... " << kv.first << "\n";
+        misaxx::utils::log_message(misaxx::utils::log_level::debug) << "[MISA++ OME] Writing results as OME TIFF " << m_path << " ... " << kv.first;
         cv::Mat tmp = misaxx::imaging::utils::tiffread(kv.second);
         opencv_to_ome(tmp, *writer, kv.first);
+        planes.add();
+        bytes.add(tmp.total() * tmp.elemSize());
 
         // Remove write buffer if requested
         if(remove_write_buffer) {
@@ -295,10 +303,10 @@ std::shared_ptr<::ome::xml::meta::OMEXMLMetadata> ome_tiff_io_impl::get_metadata
         // We are currently reading a file. Open it and fetch the metadata
         if(!m_write_buffer.empty())
             throw std::logic_error("Write buffer is active, but no metadata is set!");
-        std::cout << "[MISA++ OME] Locking " << m_path << " to obtain OME XML metadata" << "\n";
+        misaxx::utils::log_message(misaxx::utils::log_level::debug) << "[MISA++ OME] Locking " << m_path << " to obtain OME XML metadata";
         std::unique_lock<std::shared_mutex> lock { m_mutex, std::defer_lock };
         lock.lock();
-        std::cout << "[MISA++ OME] Locking " << m_path << " to obtain OME XML metadata ... successful" << "\n";
+        misaxx::utils::log_message(misaxx::utils::log_level::debug) << "[MISA++ OME] Locking " << m_path << " to obtain OME XML metadata ... successful";
         get_reader(misa_ome_plane_description(0, 0, 0, 0));
         return m_metadata;
     }
@@ -321,7 +329,13 @@ cv::Mat ome_tiff_io_impl::read_plane(const misa_ome_plane_description &index) co
         wlock.lock();
 //        std::cout << "[MISA++ OME] Locking " << m_path << " to read data from OME TIFF .. successful" << "\n";
 
-        return ome_to_opencv(*get_reader(index), index);
+        cv::Mat result = ome_to_opencv(*get_reader(index), index);
+
+        static misaxx::utils::metric_counter &planes = misaxx::utils::get_metric("io/ome-tiff/planes-read");
+        static misaxx::utils::metric_counter &bytes = misaxx::utils::get_metric("io/ome-tiff/bytes-read");
+        planes.add();
+        bytes.add(result.total() * result.elemSize());
+        return result;
     } else {
         // The write buffer contains only standard TIFFs
         return misaxx::imaging::utils::tiffread(m_write_buffer.at(index));
@@ -340,7 +354,7 @@ void ome_tiff_io_impl::write_plane(const cv::Mat &image, const misa_ome_plane_de
 
     // If the file already exists, we have to create a write buffer
     if(m_write_buffer.empty() && boost::filesystem::exists(m_path)) {
-        std::cout << "[MISA++ OME] Preparing write mode for existing OME TIFF " << m_path << " ... " << "\n";
+        misaxx::utils::log_message(misaxx::utils::log_level::info) << "[MISA++ OME] Preparing write mode for existing OME TIFF " << m_path << " ... ";
         for(size_t series = 0; series < get_num_series(); ++series) {
             m_reader->setSeries(series);
             const auto size_Z = m_reader->getSizeZ();
@@ -351,8 +365,7 @@ void ome_tiff_io_impl::write_plane(const cv::Mat &image, const misa_ome_plane_de
                 for(size_t c = 0; c < size_C; ++c) {
                     for (size_t t = 0; t < size_T; ++t) {
                         const misa_ome_plane_description location(series, z, c, t);
-                        const auto location_name = misaxx::utils::to_string(location);
-                        std::cout << "[MISA++ OME] Preparing write mode for existing OME TIFF " << m_path << " ... writing plane " << location_name << "\n";
+                        misaxx::utils::log_message(misaxx::utils::log_level::debug) << "[MISA++ OME] Preparing write mode for existing OME TIFF " << m_path << " ... writing plane " << location;
 
                         const boost::filesystem::path buffer_path = get_write_buffer_path(location);
                         if(!boost::filesystem::is_directory(buffer_path.parent_path())) {
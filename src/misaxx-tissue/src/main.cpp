@@ -12,6 +12,7 @@
 
 #include <misaxx-tissue/module.h>
 #include <misaxx/core/runtime/misa_cli.h>
+#include <misaxx/imaging/utils/parallel_backend.h>
 #include <misaxx-tissue/module_info.h>
 
 using namespace misaxx;
@@ -21,5 +22,6 @@ int main(int argc, const char** argv) {
     misa_cli cli {};
     cli.set_module_info(misaxx_tissue::module_info());
     cli.set_root_module<misaxx_tissue::module>("misaxx-tissue");
+    misaxx::imaging::utils::install_parallel_backend(cli);
     return cli.prepare_and_run(argc, argv);
 }
\ No newline at end of file
@@ -43,3 +43,9 @@ void quantification::work() {
     result.volume = result.pixels.get_volume(module->m_voxel_size);
     module->m_output_quantification.attach(std::move(result));
 }
+
+void quantification::create_cache_usage(cache_usage &t_caches) {
+    auto module = get_module_as<module_interface>();
+    t_caches.read(module->m_output_segmented);
+    t_caches.write(module->m_output_quantification);
+}
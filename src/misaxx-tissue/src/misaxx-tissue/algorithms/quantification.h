@@ -20,5 +20,6 @@ namespace misaxx_tissue {
     struct quantification : public misaxx::misa_task {
         using misaxx::misa_task::misa_task;
         void work() override;
+        void create_cache_usage(cache_usage &t_caches) override;
     };
 }
@@ -329,6 +329,11 @@ void segmentation2d_klingberg_1::create_parameters(misa_parameter_builder &t_par
     m_resize_interpolation.schema->make_enum<std::string>({ "cubic", "linear" });
 }
 
+void segmentation2d_klingberg_1::create_cache_usage(cache_usage &t_caches) {
+    t_caches.read(m_input_autofluoresence);
+    t_caches.write(m_output_segmented2d);
+}
+
 void segmentation2d_klingberg_1::work() {
 
     auto module = get_module_as<module_interface>();
@@ -33,6 +33,8 @@ namespace misaxx_tissue {
 
         void create_parameters(misaxx::misa_parameter_builder &t_parameters) override;
 
+        void create_cache_usage(cache_usage &t_caches) override;
+
         void work() override;
     };
 }
\ No newline at end of file